@@ -45,6 +45,10 @@ def launch_setup(context, *args, **kwargs):
     headless_mode = LaunchConfiguration("headless_mode")
     launch_dashboard_client = LaunchConfiguration("launch_dashboard_client")
     use_tool_communication = LaunchConfiguration("use_tool_communication")
+    use_robot_clock = LaunchConfiguration("use_robot_clock")
+    rtde_output_profile = LaunchConfiguration("rtde_output_profile").perform(context)
+    rtde_input_registers = LaunchConfiguration("rtde_input_registers").perform(context)
+    rtde_output_registers = LaunchConfiguration("rtde_output_registers").perform(context)
 
     joint_limit_params = PathJoinSubstitution(
         [FindPackageShare(description_package), "config", ur_type, "joint_limits.yaml"]
@@ -64,9 +68,35 @@ def launch_setup(context, *args, **kwargs):
     input_recipe_filename = PathJoinSubstitution(
         [FindPackageShare("ur_robot_driver"), "resources", "rtde_input_recipe.txt"]
     )
+    # The full recipe is needed for all IO and status interfaces, the other profiles only stream a
+    # subset of the RTDE outputs.
+    if rtde_output_profile == "full":
+        output_recipe_file = "rtde_output_recipe.txt"
+    elif rtde_output_profile == "dual_rate":
+        # motion related fields at full rate, IO and status on a second, low-rate connection
+        output_recipe_file = "rtde_output_recipe_force_torque.txt"
+    else:
+        output_recipe_file = "rtde_output_recipe_" + rtde_output_profile + ".txt"
     output_recipe_filename = PathJoinSubstitution(
-        [FindPackageShare("ur_robot_driver"), "resources", "rtde_output_recipe.txt"]
-    )
+        [FindPackageShare("ur_robot_driver"), "resources", output_recipe_file]
+    )
+    slow_output_recipe_args = []
+    if rtde_output_profile == "dual_rate":
+        slow_output_recipe_args = [
+            "slow_output_recipe_filename:=",
+            PathJoinSubstitution(
+                [FindPackageShare("ur_robot_driver"), "resources", "rtde_output_recipe_slow.txt"]
+            ),
+            " ",
+            "slow_output_frequency:=",
+            LaunchConfiguration("rtde_slow_output_frequency"),
+            " ",
+        ]
+    rtde_register_args = []
+    if rtde_input_registers:
+        rtde_register_args += ["rtde_input_registers:=", rtde_input_registers, " "]
+    if rtde_output_registers:
+        rtde_register_args += ["rtde_output_registers:=", rtde_output_registers, " "]
 
     robot_description_content = Command(
         [
@@ -126,6 +156,8 @@ def launch_setup(context, *args, **kwargs):
             use_tool_communication,
             " ",
         ]
+        + slow_output_recipe_args
+        + rtde_register_args
     )
     robot_description = {"robot_description": robot_description_content}
 
@@ -160,7 +192,12 @@ def launch_setup(context, *args, **kwargs):
     ur_control_node = Node(
         package="ur_robot_driver",
         executable="ur_ros2_control_node",
-        parameters=[robot_description, update_rate_config_file, initial_joint_controllers],
+        parameters=[
+            robot_description,
+            update_rate_config_file,
+            initial_joint_controllers,
+            {"use_robot_clock": use_robot_clock},
+        ],
         output={
             "stdout": "screen",
             "stderr": "screen",
@@ -226,12 +263,28 @@ def launch_setup(context, *args, **kwargs):
         ],
     )
 
+    rtde_statistics_broadcaster_spawner = Node(
+        package="controller_manager",
+        executable="spawner",
+        arguments=[
+            "rtde_statistics_broadcaster",
+            "--controller-manager",
+            "/controller_manager",
+        ],
+    )
+
     forward_position_controller_spawner_stopped = Node(
         package="controller_manager",
         executable="spawner.py",
         arguments=["forward_position_controller", "-c", "/controller_manager", "--stopped"],
     )
 
+    trajectory_forwarding_controller_spawner_stopped = Node(
+        package="controller_manager",
+        executable="spawner",
+        arguments=["trajectory_forwarding_controller", "-c", "/controller_manager", "--stopped"],
+    )
+
     # There may be other controllers of the joints, but this is the initially-started one
     initial_joint_controller_spawner_started = Node(
         package="controller_manager",
@@ -253,14 +306,23 @@ def launch_setup(context, *args, **kwargs):
         robot_state_publisher_node,
         rviz_node,
         joint_state_broadcaster_spawner,
-        io_and_status_controller_spawner,
         speed_scaling_state_broadcaster_spawner,
-        force_torque_sensor_broadcaster_spawner,
         forward_position_controller_spawner_stopped,
+        trajectory_forwarding_controller_spawner_stopped,
         initial_joint_controller_spawner_stopped,
         initial_joint_controller_spawner_started,
     ]
 
+    # Broadcasters for interfaces that are not exported with trimmed RTDE output profiles
+    if rtde_output_profile in ["full", "dual_rate"]:
+        nodes_to_start.append(io_and_status_controller_spawner)
+    if rtde_output_profile in ["full", "force_torque", "dual_rate"]:
+        nodes_to_start.append(force_torque_sensor_broadcaster_spawner)
+    # The RTDE statistics are derived from the robot's timestamp
+    with open(output_recipe_filename.perform(context)) as output_recipe:
+        if "timestamp" in output_recipe.read().split():
+            nodes_to_start.append(rtde_statistics_broadcaster_spawner)
+
     return nodes_to_start
 
 
@@ -391,5 +453,45 @@ def generate_launch_description():
             description="Only available for e series!",
         )
     )
+    declared_arguments.append(
+        DeclareLaunchArgument(
+            "use_robot_clock",
+            default_value="false",
+            description="Drive the control loop with the robot's controller clock and the period measured \
+        on the robot instead of the host clock.",
+        )
+    )
+    declared_arguments.append(
+        DeclareLaunchArgument(
+            "rtde_output_profile",
+            default_value="full",
+            description="RTDE output recipe profile. Every field of the recipe is exported as state \
+        interface, trimmed profiles reduce the RTDE payload and the decoding time.",
+            choices=["full", "force_torque", "minimal", "dual_rate"],
+        )
+    )
+    declared_arguments.append(
+        DeclareLaunchArgument(
+            "rtde_slow_output_frequency",
+            default_value="10",
+            description="Frequency of the low-rate RTDE connection used by the dual_rate output profile.",
+        )
+    )
+    declared_arguments.append(
+        DeclareLaunchArgument(
+            "rtde_input_registers",
+            default_value="",
+            description="Comma separated RTDE input registers exported as command interfaces, e.g. \
+        'input_int_register_24,input_bit_register_64'.",
+        )
+    )
+    declared_arguments.append(
+        DeclareLaunchArgument(
+            "rtde_output_registers",
+            default_value="",
+            description="Comma separated RTDE output registers exported as state interfaces, e.g. \
+        'output_int_register_24,output_double_register_24'.",
+        )
+    )
 
     return LaunchDescription(declared_arguments + [OpaqueFunction(function=launch_setup)])
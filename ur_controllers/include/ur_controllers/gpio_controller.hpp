@@ -24,6 +24,7 @@
 #ifndef UR_CONTROLLERS__GPIO_CONTROLLER_HPP_
 #define UR_CONTROLLERS__GPIO_CONTROLLER_HPP_
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -78,6 +79,7 @@ enum StateInterfaces
   SAFETY_MODE = 57,
   SAFETY_STATUS_BITS = 58,
   INITIALIZED_FLAG = 69,
+  CHANGE_SEQ = 70,
 };
 
 class GPIOController : public controller_interface::ControllerInterface
@@ -122,6 +124,9 @@ protected:
 
   bool first_pass_;
 
+  // change sequence of the gpio values converted into io_msg_ last
+  double last_change_seq_;
+
   // internal commands
   std::array<double, 18> standard_digital_output_cmd_;
   std::array<double, 18> standard_analog_output_cmd_;
@@ -144,6 +149,9 @@ protected:
   ur_dashboard_msgs::msg::SafetyMode safety_mode_msg_;
 
   static constexpr double ASYNC_WAITING = 2.0;
+  // The hardware dispatches requests within the next control cycle, so polling for the result more
+  // often than every millisecond does not pay off.
+  static constexpr std::chrono::milliseconds ASYNC_POLL_PERIOD{ 1 };
   // TODO(anyone) publishers to add: program_state_pub_, tcp_pose_pub_
   // TODO(anyone) subscribers to add: script_command_sub_
   // TODO(anyone) service servers to add: resend_robot_program_srv_, deactivate_srv_, set_payload_srv_, tare_sensor_srv_
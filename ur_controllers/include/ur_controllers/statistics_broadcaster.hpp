@@ -0,0 +1,75 @@
+// Copyright 2026 FZI Forschungszentrum Informatik
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+
+#ifndef UR_CONTROLLERS__STATISTICS_BROADCASTER_HPP_
+#define UR_CONTROLLERS__STATISTICS_BROADCASTER_HPP_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "controller_interface/controller_interface.hpp"
+#include "rclcpp_lifecycle/node_interfaces/lifecycle_node_interface.hpp"
+#include "rclcpp/time.hpp"
+#include "rclcpp/duration.hpp"
+#include "realtime_tools/realtime_publisher.h"
+#include "std_msgs/msg/float64_multi_array.hpp"
+
+namespace ur_controllers
+{
+/*!
+ * \brief Publishes a set of state interfaces, e.g. the RTDE connection statistics of the hardware
+ * interface, as array of doubles at a fixed rate. The values are ordered like the configured
+ * interfaces. The message is handed to a realtime publisher, so the actual publishing happens
+ * outside of the control loop.
+ */
+class StatisticsBroadcaster : public controller_interface::ControllerInterface
+{
+public:
+  controller_interface::InterfaceConfiguration command_interface_configuration() const override;
+
+  controller_interface::InterfaceConfiguration state_interface_configuration() const override;
+
+  controller_interface::return_type update(const rclcpp::Time& time, const rclcpp::Duration& period) override;
+
+  rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn
+  on_configure(const rclcpp_lifecycle::State& previous_state) override;
+
+  rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn
+  on_activate(const rclcpp_lifecycle::State& previous_state) override;
+
+  rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn
+  on_deactivate(const rclcpp_lifecycle::State& previous_state) override;
+
+  rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn on_init() override;
+
+protected:
+  std::vector<std::string> interface_names_;
+  double publish_rate_;
+  bool first_update_;
+  rclcpp::Time last_publish_time_;
+
+  std::shared_ptr<rclcpp::Publisher<std_msgs::msg::Float64MultiArray>> statistics_publisher_;
+  std::unique_ptr<realtime_tools::RealtimePublisher<std_msgs::msg::Float64MultiArray>> realtime_publisher_;
+};
+}  // namespace ur_controllers
+#endif  // UR_CONTROLLERS__STATISTICS_BROADCASTER_HPP_
@@ -0,0 +1,127 @@
+// Copyright 2026 FZI Forschungszentrum Informatik
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+
+#ifndef UR_CONTROLLERS__TRAJECTORY_FORWARDING_CONTROLLER_HPP_
+#define UR_CONTROLLERS__TRAJECTORY_FORWARDING_CONTROLLER_HPP_
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "control_msgs/action/follow_joint_trajectory.hpp"
+#include "controller_interface/controller_interface.hpp"
+#include "rclcpp_action/server.hpp"
+#include "rclcpp_lifecycle/node_interfaces/lifecycle_node_interface.hpp"
+#include "rclcpp/time.hpp"
+#include "rclcpp/duration.hpp"
+#include "realtime_tools/realtime_buffer.h"
+#include "realtime_tools/realtime_server_goal_handle.h"
+
+namespace ur_controllers
+{
+/*!
+ * \brief Forwards FollowJointTrajectory goals to the robot, which executes them with its own
+ * interpolation.
+ *
+ * The points of a goal are handed to the hardware interface one per cycle through the
+ * "trajectory_forwarding" command interfaces. The hardware interface passes them on to the robot
+ * program, which buffers them and reports its progress back. Unlike the joint trajectory controllers,
+ * a missed cycle of the control loop does not affect the motion.
+ */
+class TrajectoryForwardingController : public controller_interface::ControllerInterface
+{
+public:
+  using FollowJTrajAction = control_msgs::action::FollowJointTrajectory;
+  using RealtimeGoalHandle = realtime_tools::RealtimeServerGoalHandle<FollowJTrajAction>;
+
+  controller_interface::InterfaceConfiguration command_interface_configuration() const override;
+
+  controller_interface::InterfaceConfiguration state_interface_configuration() const override;
+
+  controller_interface::return_type update(const rclcpp::Time& time, const rclcpp::Duration& period) override;
+
+  rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn
+  on_configure(const rclcpp_lifecycle::State& previous_state) override;
+
+  rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn
+  on_activate(const rclcpp_lifecycle::State& previous_state) override;
+
+  rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn
+  on_deactivate(const rclcpp_lifecycle::State& previous_state) override;
+
+  rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn on_init() override;
+
+protected:
+  /*!
+   * \brief Goal converted into the layout of the command interfaces, so update() only copies values.
+   */
+  struct ForwardedGoal
+  {
+    struct Point
+    {
+      std::array<double, 6> positions;
+      std::array<double, 6> velocities;
+      double time_from_start;
+    };
+
+    std::shared_ptr<RealtimeGoalHandle> handle;
+    std::vector<Point> points;
+    std::shared_ptr<FollowJTrajAction::Result> result;
+    std::atomic<bool> cancel_requested;
+  };
+
+  rclcpp_action::GoalResponse goalCallback(const rclcpp_action::GoalUUID& uuid,
+                                           std::shared_ptr<const FollowJTrajAction::Goal> goal);
+
+  rclcpp_action::CancelResponse
+  cancelCallback(const std::shared_ptr<rclcpp_action::ServerGoalHandle<FollowJTrajAction>> goal_handle);
+
+  void acceptedCallback(std::shared_ptr<rclcpp_action::ServerGoalHandle<FollowJTrajAction>> goal_handle);
+
+  /*!
+   * \brief Reports the outcome of the goal executed by update() and forgets about it.
+   */
+  void finishGoal(double result);
+
+  std::vector<std::string> joint_names_;
+  double action_monitor_rate_;
+
+  rclcpp_action::Server<FollowJTrajAction>::SharedPtr action_server_;
+  rclcpp::TimerBase::SharedPtr goal_handle_timer_;
+  // goal accepted last, only used by the action callbacks
+  std::shared_ptr<ForwardedGoal> accepted_goal_;
+  realtime_tools::RealtimeBuffer<std::shared_ptr<ForwardedGoal>> goal_buffer_;
+
+  // goal executed by update()
+  std::shared_ptr<ForwardedGoal> current_goal_;
+  size_t next_point_;
+  // the hardware interface took over the first point, so the result interface refers to this goal
+  bool started_;
+  bool abort_sent_;
+  bool goal_done_;
+  // a preempted trajectory is still moving the robot
+  bool waiting_for_stop_;
+};
+}  // namespace ur_controllers
+#endif  // UR_CONTROLLERS__TRAJECTORY_FORWARDING_CONTROLLER_HPP_
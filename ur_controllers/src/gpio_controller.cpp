@@ -23,10 +23,14 @@
 
 #include "ur_controllers/gpio_controller.hpp"
 
+#include <limits>
 #include <string>
 
 namespace ur_controllers
 {
+// sleep_for() takes its argument by reference, which needs a definition before C++17
+constexpr std::chrono::milliseconds GPIOController::ASYNC_POLL_PERIOD;
+
 rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn GPIOController::on_init()
 {
   initMsgs();
@@ -119,6 +123,7 @@ controller_interface::InterfaceConfiguration ur_controllers::GPIOController::sta
     config.names.emplace_back("gpio/safety_status_bit_" + std::to_string(i));
   }
   config.names.emplace_back("system_interface/initialized");
+  config.names.emplace_back("gpio/change_seq");
 
   return config;
 }
@@ -141,29 +146,37 @@ ur_controllers::GPIOController::on_configure(const rclcpp_lifecycle::State& /*pr
 
 void GPIOController::publishIO()
 {
-  for (size_t i = 0; i < 18; ++i) {
-    io_msg_.digital_out_states[i].pin = i;
-    io_msg_.digital_out_states[i].state = static_cast<bool>(state_interfaces_[i].get_value());
+  // The digital states and analog domains only have to be read if the hardware reports a change.
+  // The sequence starts out as NaN, so the first cycle always reads them.
+  const double change_seq = state_interfaces_[StateInterfaces::CHANGE_SEQ].get_value();
+  if (change_seq != last_change_seq_) {
+    for (size_t i = 0; i < 18; ++i) {
+      io_msg_.digital_out_states[i].pin = i;
+      io_msg_.digital_out_states[i].state = static_cast<bool>(state_interfaces_[i].get_value());
+
+      io_msg_.digital_in_states[i].pin = i;
+      io_msg_.digital_in_states[i].state =
+          static_cast<bool>(state_interfaces_[i + StateInterfaces::DIGITAL_INPUTS].get_value());
+    }
 
-    io_msg_.digital_in_states[i].pin = i;
-    io_msg_.digital_in_states[i].state =
-        static_cast<bool>(state_interfaces_[i + StateInterfaces::DIGITAL_INPUTS].get_value());
+    for (size_t i = 0; i < 2; ++i) {
+      io_msg_.analog_in_states[i].pin = i;
+      io_msg_.analog_in_states[i].domain =
+          static_cast<uint8_t>(state_interfaces_[i + StateInterfaces::ANALOG_IO_TYPES].get_value());
+
+      io_msg_.analog_out_states[i].pin = i;
+      io_msg_.analog_out_states[i].domain =
+          static_cast<uint8_t>(state_interfaces_[i + StateInterfaces::ANALOG_IO_TYPES + 2].get_value());
+    }
+    last_change_seq_ = change_seq;
   }
 
+  // analog values are not covered by the change sequence
   for (size_t i = 0; i < 2; ++i) {
-    io_msg_.analog_in_states[i].pin = i;
     io_msg_.analog_in_states[i].state =
         static_cast<float>(state_interfaces_[i + StateInterfaces::ANALOG_INPUTS].get_value());
-    io_msg_.analog_in_states[i].domain =
-        static_cast<uint8_t>(state_interfaces_[i + StateInterfaces::ANALOG_IO_TYPES].get_value());
-  }
-
-  for (size_t i = 0; i < 2; ++i) {
-    io_msg_.analog_out_states[i].pin = i;
     io_msg_.analog_out_states[i].state =
         static_cast<float>(state_interfaces_[i + StateInterfaces::ANALOG_OUTPUTS].get_value());
-    io_msg_.analog_out_states[i].domain =
-        static_cast<uint8_t>(state_interfaces_[i + StateInterfaces::ANALOG_IO_TYPES + 2].get_value());
   }
 
   io_pub_->publish(io_msg_);
@@ -210,6 +223,8 @@ void GPIOController::publishSafetyMode()
 rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn
 ur_controllers::GPIOController::on_activate(const rclcpp_lifecycle::State& /*previous_state*/)
 {
+  last_change_seq_ = std::numeric_limits<double>::quiet_NaN();
+
   while (state_interfaces_[StateInterfaces::INITIALIZED_FLAG].get_value() == 0.0) {
     RCLCPP_INFO(get_node()->get_logger(), "Waiting for system interface to initialize...");
     std::this_thread::sleep_for(std::chrono::milliseconds(50));
@@ -275,7 +290,7 @@ bool GPIOController::setIO(ur_msgs::srv::SetIO::Request::SharedPtr req, ur_msgs:
 
     while (command_interfaces_[CommandInterfaces::IO_ASYNC_SUCCESS].get_value() == ASYNC_WAITING) {
       // Asynchronous wait until the hardware interface has set the io value
-      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      std::this_thread::sleep_for(ASYNC_POLL_PERIOD);
     }
 
     resp->success = static_cast<bool>(command_interfaces_[IO_ASYNC_SUCCESS].get_value());
@@ -289,7 +304,7 @@ bool GPIOController::setIO(ur_msgs::srv::SetIO::Request::SharedPtr req, ur_msgs:
 
     while (command_interfaces_[CommandInterfaces::IO_ASYNC_SUCCESS].get_value() == ASYNC_WAITING) {
       // Asynchronous wait until the hardware interface has set the io value
-      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      std::this_thread::sleep_for(ASYNC_POLL_PERIOD);
     }
 
     resp->success = static_cast<bool>(command_interfaces_[CommandInterfaces::IO_ASYNC_SUCCESS].get_value());
@@ -313,7 +328,7 @@ bool GPIOController::setSpeedSlider(ur_msgs::srv::SetSpeedSliderFraction::Reques
 
     while (command_interfaces_[CommandInterfaces::TARGET_SPEED_FRACTION_ASYNC_SUCCESS].get_value() == ASYNC_WAITING) {
       // Asynchronouse wait until the hardware interface has set the slider value
-      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      std::this_thread::sleep_for(ASYNC_POLL_PERIOD);
     }
     resp->success =
         static_cast<bool>(command_interfaces_[CommandInterfaces::TARGET_SPEED_FRACTION_ASYNC_SUCCESS].get_value());
@@ -336,7 +351,7 @@ bool GPIOController::resendRobotProgram(std_srvs::srv::Trigger::Request::SharedP
 
   while (command_interfaces_[CommandInterfaces::RESEND_ROBOT_PROGRAM_ASYNC_SUCCESS].get_value() == ASYNC_WAITING) {
     // Asynchronous wait until the hardware interface has set the slider value
-    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    std::this_thread::sleep_for(ASYNC_POLL_PERIOD);
   }
   resp->success =
       static_cast<bool>(command_interfaces_[CommandInterfaces::RESEND_ROBOT_PROGRAM_ASYNC_SUCCESS].get_value());
@@ -364,7 +379,7 @@ bool GPIOController::setPayload(const ur_msgs::srv::SetPayload::Request::SharedP
 
   while (command_interfaces_[CommandInterfaces::PAYLOAD_ASYNC_SUCCESS].get_value() == ASYNC_WAITING) {
     // Asynchronous wait until the hardware interface has set the payload
-    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    std::this_thread::sleep_for(ASYNC_POLL_PERIOD);
   }
 
   resp->success = static_cast<bool>(command_interfaces_[CommandInterfaces::PAYLOAD_ASYNC_SUCCESS].get_value());
@@ -0,0 +1,143 @@
+// Copyright 2026 FZI Forschungszentrum Informatik
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+
+#include "ur_controllers/statistics_broadcaster.hpp"
+
+#include <string>
+#include <vector>
+
+#include "rclcpp/qos.hpp"
+#include "rclcpp_lifecycle/lifecycle_node.hpp"
+
+namespace ur_controllers
+{
+rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn StatisticsBroadcaster::on_init()
+{
+  try {
+    auto_declare<double>("state_publish_rate", 1.0);
+    // RTDE connection statistics and connection supervision of the UR hardware interface
+    auto_declare<std::vector<std::string>>("interfaces", { "system_interface/rtde_received_packets",
+                                                           "system_interface/rtde_missed_packets",
+                                                           "system_interface/rtde_late_packets",
+                                                           "system_interface/rtde_duplicate_packets",
+                                                           "system_interface/rtde_max_gap",
+                                                           "system_interface/stale_cycles",
+                                                           "system_interface/consecutive_stale_cycles",
+                                                           "system_interface/robot_connected",
+                                                           "system_interface/reconnects",
+                                                           "system_interface/last_recovery_duration" });
+  } catch (std::exception& e) {
+    fprintf(stderr, "Exception thrown during init stage with message: %s \n", e.what());
+    return rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn::ERROR;
+  }
+
+  return rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn::SUCCESS;
+}
+
+controller_interface::InterfaceConfiguration StatisticsBroadcaster::command_interface_configuration() const
+{
+  return controller_interface::InterfaceConfiguration{ controller_interface::interface_configuration_type::NONE };
+}
+
+controller_interface::InterfaceConfiguration StatisticsBroadcaster::state_interface_configuration() const
+{
+  controller_interface::InterfaceConfiguration config;
+  config.type = controller_interface::interface_configuration_type::INDIVIDUAL;
+  config.names = interface_names_;
+  return config;
+}
+
+rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn
+StatisticsBroadcaster::on_configure(const rclcpp_lifecycle::State& /*previous_state*/)
+{
+  publish_rate_ = get_node()->get_parameter("state_publish_rate").as_double();
+  interface_names_ = get_node()->get_parameter("interfaces").as_string_array();
+  if (interface_names_.empty()) {
+    RCLCPP_ERROR(get_node()->get_logger(), "Parameter 'interfaces' is empty");
+    return rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn::ERROR;
+  }
+  RCLCPP_INFO(get_node()->get_logger(), "Publisher rate set to : %.1f Hz", publish_rate_);
+
+  try {
+    statistics_publisher_ = get_node()->create_publisher<std_msgs::msg::Float64MultiArray>(
+        "~/statistics", rclcpp::SystemDefaultsQoS());
+    realtime_publisher_ =
+        std::make_unique<realtime_tools::RealtimePublisher<std_msgs::msg::Float64MultiArray>>(
+            statistics_publisher_);
+  } catch (const std::exception& e) {
+    // get_node() may throw, logging raw here
+    fprintf(stderr, "Exception thrown during init stage with message: %s \n", e.what());
+    return rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn::ERROR;
+  }
+
+  // The message layout stays the same, update() only copies the values without allocating.
+  auto& msg = realtime_publisher_->msg_;
+  msg.layout.dim.resize(1);
+  msg.layout.dim[0].label = "interfaces";
+  msg.layout.dim[0].size = interface_names_.size();
+  msg.layout.dim[0].stride = interface_names_.size();
+  msg.layout.data_offset = 0;
+  msg.data.resize(interface_names_.size(), 0.0);
+
+  return rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn::SUCCESS;
+}
+
+rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn
+StatisticsBroadcaster::on_activate(const rclcpp_lifecycle::State& /*previous_state*/)
+{
+  first_update_ = true;
+  return rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn::SUCCESS;
+}
+
+rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn
+StatisticsBroadcaster::on_deactivate(const rclcpp_lifecycle::State& /*previous_state*/)
+{
+  return rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn::SUCCESS;
+}
+
+controller_interface::return_type StatisticsBroadcaster::update(const rclcpp::Time& time,
+                                                                const rclcpp::Duration& /*period*/)
+{
+  if (publish_rate_ <= 0.0) {
+    return controller_interface::return_type::OK;
+  }
+  if (!first_update_ && (time - last_publish_time_).seconds() < 1.0 / publish_rate_) {
+    return controller_interface::return_type::OK;
+  }
+
+  // If the publisher thread is still busy with the last message, try again in the next cycle.
+  if (realtime_publisher_->trylock()) {
+    auto& msg = realtime_publisher_->msg_;
+    for (size_t i = 0; i < state_interfaces_.size(); ++i) {
+      msg.data[i] = state_interfaces_[i].get_value();
+    }
+    realtime_publisher_->unlockAndPublish();
+    last_publish_time_ = time;
+    first_update_ = false;
+  }
+  return controller_interface::return_type::OK;
+}
+}  // namespace ur_controllers
+
+#include "pluginlib/class_list_macros.hpp"
+
+PLUGINLIB_EXPORT_CLASS(ur_controllers::StatisticsBroadcaster, controller_interface::ControllerInterface)
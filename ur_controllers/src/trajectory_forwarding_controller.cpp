@@ -0,0 +1,371 @@
+// Copyright 2026 FZI Forschungszentrum Informatik
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+
+#include "ur_controllers/trajectory_forwarding_controller.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "lifecycle_msgs/msg/state.hpp"
+#include "rclcpp_action/create_server.hpp"
+#include "rclcpp_lifecycle/lifecycle_node.hpp"
+
+namespace ur_controllers
+{
+namespace
+{
+// Layout of the "trajectory_forwarding" interfaces of the UR hardware interface
+enum CommandInterfaces
+{
+  SETPOINT_POSITIONS = 0u,
+  SETPOINT_VELOCITIES = 6,
+  TIME_FROM_START = 12,
+  NUMBER_OF_POINTS = 13,
+  TRANSFER_STATE = 14,
+  ABORT = 15,
+};
+
+enum StateInterfaces
+{
+  POINTS_DONE = 0u,
+  RESULT = 1,
+};
+
+constexpr double TRANSFER_IDLE = 0.0;
+constexpr double TRANSFER_POINT_READY = 1.0;
+
+constexpr double RESULT_RUNNING = 0.0;
+constexpr double RESULT_SUCCESS = 1.0;
+constexpr double RESULT_CANCELED = 2.0;
+}  // namespace
+
+rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn TrajectoryForwardingController::on_init()
+{
+  try {
+    // joints of the robot in the order of the hardware interface
+    auto_declare<std::vector<std::string>>("joints", std::vector<std::string>());
+    auto_declare<double>("action_monitor_rate", 20.0);
+  } catch (std::exception& e) {
+    fprintf(stderr, "Exception thrown during init stage with message: %s \n", e.what());
+    return rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn::ERROR;
+  }
+
+  return rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn::SUCCESS;
+}
+
+controller_interface::InterfaceConfiguration TrajectoryForwardingController::command_interface_configuration() const
+{
+  controller_interface::InterfaceConfiguration config;
+  config.type = controller_interface::interface_configuration_type::INDIVIDUAL;
+
+  for (size_t i = 0; i < 6; ++i) {
+    config.names.emplace_back("trajectory_forwarding/setpoint_position_" + std::to_string(i));
+  }
+  for (size_t i = 0; i < 6; ++i) {
+    config.names.emplace_back("trajectory_forwarding/setpoint_velocity_" + std::to_string(i));
+  }
+  config.names.emplace_back("trajectory_forwarding/time_from_start");
+  config.names.emplace_back("trajectory_forwarding/number_of_points");
+  config.names.emplace_back("trajectory_forwarding/transfer_state");
+  config.names.emplace_back("trajectory_forwarding/abort");
+
+  return config;
+}
+
+controller_interface::InterfaceConfiguration TrajectoryForwardingController::state_interface_configuration() const
+{
+  controller_interface::InterfaceConfiguration config;
+  config.type = controller_interface::interface_configuration_type::INDIVIDUAL;
+
+  config.names.emplace_back("trajectory_forwarding/points_done");
+  config.names.emplace_back("trajectory_forwarding/result");
+
+  return config;
+}
+
+rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn
+TrajectoryForwardingController::on_configure(const rclcpp_lifecycle::State& /*previous_state*/)
+{
+  joint_names_ = get_node()->get_parameter("joints").as_string_array();
+  if (joint_names_.size() != 6) {
+    RCLCPP_ERROR(get_node()->get_logger(), "Parameter 'joints' has to contain the 6 joints of the robot.");
+    return rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn::ERROR;
+  }
+  action_monitor_rate_ = get_node()->get_parameter("action_monitor_rate").as_double();
+  if (action_monitor_rate_ <= 0.0) {
+    RCLCPP_ERROR(get_node()->get_logger(), "Parameter 'action_monitor_rate' has to be positive.");
+    return rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn::ERROR;
+  }
+
+  using namespace std::placeholders;
+  action_server_ = rclcpp_action::create_server<FollowJTrajAction>(
+      get_node()->get_node_base_interface(), get_node()->get_node_clock_interface(),
+      get_node()->get_node_logging_interface(), get_node()->get_node_waitables_interface(),
+      std::string(get_node()->get_name()) + "/follow_joint_trajectory",
+      std::bind(&TrajectoryForwardingController::goalCallback, this, _1, _2),
+      std::bind(&TrajectoryForwardingController::cancelCallback, this, _1),
+      std::bind(&TrajectoryForwardingController::acceptedCallback, this, _1));
+
+  return rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn::SUCCESS;
+}
+
+rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn
+TrajectoryForwardingController::on_activate(const rclcpp_lifecycle::State& /*previous_state*/)
+{
+  goal_buffer_.writeFromNonRT(std::shared_ptr<ForwardedGoal>());
+  current_goal_.reset();
+  next_point_ = 0;
+  started_ = false;
+  abort_sent_ = false;
+  goal_done_ = false;
+  waiting_for_stop_ = false;
+  return rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn::SUCCESS;
+}
+
+rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn
+TrajectoryForwardingController::on_deactivate(const rclcpp_lifecycle::State& /*previous_state*/)
+{
+  // the hardware interface cancels the trajectory on the robot when the interfaces are released
+  if (accepted_goal_) {
+    accepted_goal_->result->error_string = "Controller was deactivated.";
+    accepted_goal_->handle->setAborted(accepted_goal_->result);
+    accepted_goal_->handle->runNonRealtime();
+    accepted_goal_.reset();
+  }
+  goal_handle_timer_.reset();
+  goal_buffer_.writeFromNonRT(std::shared_ptr<ForwardedGoal>());
+  current_goal_.reset();
+  return rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn::SUCCESS;
+}
+
+controller_interface::return_type TrajectoryForwardingController::update(const rclcpp::Time& /*time*/,
+                                                                         const rclcpp::Duration& /*period*/)
+{
+  const std::shared_ptr<ForwardedGoal> goal = *goal_buffer_.readFromRT();
+  if (goal != current_goal_) {
+    // A new goal preempts the trajectory the robot executes, which has to stop before the new one
+    // can start. The action callbacks already reported the preemption.
+    if (current_goal_ && started_ && !goal_done_) {
+      waiting_for_stop_ = true;
+    }
+    // a point the hardware interface did not take yet is withdrawn
+    command_interfaces_[TRANSFER_STATE].set_value(TRANSFER_IDLE);
+    current_goal_ = goal;
+    next_point_ = 0;
+    started_ = false;
+    abort_sent_ = false;
+    goal_done_ = false;
+  }
+
+  if (waiting_for_stop_) {
+    if (state_interfaces_[RESULT].get_value() == RESULT_RUNNING) {
+      command_interfaces_[ABORT].set_value(1.0);
+      return controller_interface::return_type::OK;
+    }
+    waiting_for_stop_ = false;
+  }
+
+  if (!current_goal_ || goal_done_) {
+    return controller_interface::return_type::OK;
+  }
+
+  // the hardware interface resets the transfer state once it took over a point
+  const bool point_pending = command_interfaces_[TRANSFER_STATE].get_value() == TRANSFER_POINT_READY;
+  if (next_point_ > 0 && !point_pending) {
+    started_ = true;
+  }
+
+  if (current_goal_->cancel_requested && !abort_sent_) {
+    if (!started_) {
+      command_interfaces_[TRANSFER_STATE].set_value(TRANSFER_IDLE);
+      finishGoal(RESULT_CANCELED);
+      return controller_interface::return_type::OK;
+    }
+    command_interfaces_[ABORT].set_value(1.0);
+    abort_sent_ = true;
+  }
+
+  if (!abort_sent_ && !point_pending && next_point_ < current_goal_->points.size()) {
+    const ForwardedGoal::Point& point = current_goal_->points[next_point_];
+    for (size_t i = 0; i < 6; ++i) {
+      command_interfaces_[SETPOINT_POSITIONS + i].set_value(point.positions[i]);
+      command_interfaces_[SETPOINT_VELOCITIES + i].set_value(point.velocities[i]);
+    }
+    command_interfaces_[TIME_FROM_START].set_value(point.time_from_start);
+    command_interfaces_[NUMBER_OF_POINTS].set_value(static_cast<double>(current_goal_->points.size()));
+    command_interfaces_[TRANSFER_STATE].set_value(TRANSFER_POINT_READY);
+    ++next_point_;
+  }
+
+  // the result interface only refers to this goal once the first point was taken over
+  if (started_) {
+    const double result = state_interfaces_[RESULT].get_value();
+    if (result != RESULT_RUNNING) {
+      finishGoal(result);
+    }
+  }
+
+  return controller_interface::return_type::OK;
+}
+
+void TrajectoryForwardingController::finishGoal(double result)
+{
+  const std::shared_ptr<FollowJTrajAction::Result>& action_result = current_goal_->result;
+  if (current_goal_->cancel_requested) {
+    // a canceling goal can't succeed anymore, even if the robot reached the last point meanwhile
+    current_goal_->handle->setCanceled(action_result);
+  } else if (result == RESULT_SUCCESS) {
+    action_result->error_code = FollowJTrajAction::Result::SUCCESSFUL;
+    current_goal_->handle->setSucceeded(action_result);
+  } else {
+    action_result->error_code = FollowJTrajAction::Result::INVALID_GOAL;
+    action_result->error_string = result == RESULT_CANCELED ? "Robot stopped the trajectory." :
+                                                              "Robot failed to execute the trajectory.";
+    current_goal_->handle->setAborted(action_result);
+  }
+  goal_done_ = true;
+}
+
+rclcpp_action::GoalResponse
+TrajectoryForwardingController::goalCallback(const rclcpp_action::GoalUUID& /*uuid*/,
+                                             std::shared_ptr<const FollowJTrajAction::Goal> goal)
+{
+  if (get_node()->get_current_state().id() != lifecycle_msgs::msg::State::PRIMARY_STATE_ACTIVE) {
+    RCLCPP_ERROR(get_node()->get_logger(), "Can't accept new action goals. Controller is not running.");
+    return rclcpp_action::GoalResponse::REJECT;
+  }
+
+  const trajectory_msgs::msg::JointTrajectory& trajectory = goal->trajectory;
+  if (trajectory.points.empty()) {
+    RCLCPP_ERROR(get_node()->get_logger(), "Rejecting a trajectory without points.");
+    return rclcpp_action::GoalResponse::REJECT;
+  }
+  if (trajectory.joint_names.size() != joint_names_.size()) {
+    RCLCPP_ERROR(get_node()->get_logger(), "Rejecting a trajectory that does not contain all %zu joints.",
+                 joint_names_.size());
+    return rclcpp_action::GoalResponse::REJECT;
+  }
+  for (const std::string& joint_name : joint_names_) {
+    if (std::find(trajectory.joint_names.begin(), trajectory.joint_names.end(), joint_name) ==
+        trajectory.joint_names.end()) {
+      RCLCPP_ERROR(get_node()->get_logger(), "Rejecting a trajectory without joint '%s'.", joint_name.c_str());
+      return rclcpp_action::GoalResponse::REJECT;
+    }
+  }
+
+  double last_time_from_start = 0.0;
+  for (const trajectory_msgs::msg::JointTrajectoryPoint& point : trajectory.points) {
+    if (point.positions.size() != joint_names_.size() ||
+        (!point.velocities.empty() && point.velocities.size() != joint_names_.size())) {
+      RCLCPP_ERROR(get_node()->get_logger(), "Rejecting a trajectory with points not matching its joints.");
+      return rclcpp_action::GoalResponse::REJECT;
+    }
+    const double time_from_start = rclcpp::Duration(point.time_from_start).seconds();
+    if (time_from_start < last_time_from_start) {
+      RCLCPP_ERROR(get_node()->get_logger(), "Rejecting a trajectory with decreasing time_from_start.");
+      return rclcpp_action::GoalResponse::REJECT;
+    }
+    last_time_from_start = time_from_start;
+  }
+
+  return rclcpp_action::GoalResponse::ACCEPT_AND_EXECUTE;
+}
+
+rclcpp_action::CancelResponse TrajectoryForwardingController::cancelCallback(
+    const std::shared_ptr<rclcpp_action::ServerGoalHandle<FollowJTrajAction>> goal_handle)
+{
+  // only the goal executed last can still be canceled, update() reports when the robot stopped
+  if (!accepted_goal_ || accepted_goal_->handle->gh_ != goal_handle) {
+    return rclcpp_action::CancelResponse::REJECT;
+  }
+  accepted_goal_->cancel_requested = true;
+  return rclcpp_action::CancelResponse::ACCEPT;
+}
+
+void TrajectoryForwardingController::acceptedCallback(
+    std::shared_ptr<rclcpp_action::ServerGoalHandle<FollowJTrajAction>> goal_handle)
+{
+  auto forwarded_goal = std::make_shared<ForwardedGoal>();
+  forwarded_goal->handle = std::make_shared<RealtimeGoalHandle>(goal_handle);
+  forwarded_goal->result = std::make_shared<FollowJTrajAction::Result>();
+  forwarded_goal->cancel_requested = false;
+
+  // reorder the joints into the order of the hardware interface
+  const trajectory_msgs::msg::JointTrajectory& trajectory = goal_handle->get_goal()->trajectory;
+  std::array<size_t, 6> mapping;
+  for (size_t i = 0; i < 6; ++i) {
+    mapping[i] = static_cast<size_t>(
+        std::find(trajectory.joint_names.begin(), trajectory.joint_names.end(), joint_names_[i]) -
+        trajectory.joint_names.begin());
+  }
+
+  forwarded_goal->points.resize(trajectory.points.size());
+  for (size_t p = 0; p < trajectory.points.size(); ++p) {
+    const trajectory_msgs::msg::JointTrajectoryPoint& point = trajectory.points[p];
+    ForwardedGoal::Point& forwarded_point = forwarded_goal->points[p];
+    forwarded_point.time_from_start = rclcpp::Duration(point.time_from_start).seconds();
+    for (size_t i = 0; i < 6; ++i) {
+      forwarded_point.positions[i] = point.positions[mapping[i]];
+      forwarded_point.velocities[i] = point.velocities.empty() ? 0.0 : point.velocities[mapping[i]];
+    }
+  }
+
+  // Points without velocities pass through with the velocity of the central difference, the first
+  // and the last point are approached at rest.
+  for (size_t p = 1; p + 1 < trajectory.points.size(); ++p) {
+    if (!trajectory.points[p].velocities.empty()) {
+      continue;
+    }
+    const ForwardedGoal::Point& previous = forwarded_goal->points[p - 1];
+    const ForwardedGoal::Point& next = forwarded_goal->points[p + 1];
+    const double duration = next.time_from_start - previous.time_from_start;
+    if (duration <= 0.0) {
+      continue;
+    }
+    for (size_t i = 0; i < 6; ++i) {
+      forwarded_goal->points[p].velocities[i] = (next.positions[i] - previous.positions[i]) / duration;
+    }
+  }
+
+  // the new goal preempts the one executed so far
+  if (accepted_goal_) {
+    accepted_goal_->result->error_string = "Goal was preempted by a new goal.";
+    accepted_goal_->handle->setAborted(accepted_goal_->result);
+    accepted_goal_->handle->runNonRealtime();
+  }
+  accepted_goal_ = forwarded_goal;
+  goal_buffer_.writeFromNonRT(forwarded_goal);
+
+  // the realtime goal handle reports the outcome from the control thread through this timer
+  goal_handle_timer_.reset();
+  goal_handle_timer_ = get_node()->create_wall_timer(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(1.0 / action_monitor_rate_)),
+      std::bind(&RealtimeGoalHandle::runNonRealtime, forwarded_goal->handle));
+}
+}  // namespace ur_controllers
+
+#include "pluginlib/class_list_macros.hpp"
+
+PLUGINLIB_EXPORT_CLASS(ur_controllers::TrajectoryForwardingController, controller_interface::ControllerInterface)
@@ -0,0 +1,172 @@
+// Copyright 2026 FZI Forschungszentrum Informatik
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-16
+ *
+ * Micro-benchmark for the per-cycle cost of decoding an RTDE output package. Usage:
+ *
+ *   rtde_decode_benchmark [output_recipe_file] [iterations]
+ */
+//----------------------------------------------------------------------
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "ur_robot_driver/rtde_output_binding.hpp"
+
+namespace rtde = urcl::rtde_interface;
+
+namespace
+{
+struct DecodedState
+{
+  urcl::vector6d_t joint_positions;
+  urcl::vector6d_t joint_velocities;
+  urcl::vector6d_t joint_efforts;
+  urcl::vector6d_t ft_sensor_measurements;
+  urcl::vector6d_t tcp_pose;
+  double target_speed_fraction;
+  double speed_scaling;
+  uint32_t runtime_state;
+  std::array<double, 2> standard_analog_input;
+  std::array<double, 2> standard_analog_output;
+  uint32_t tool_mode;
+  std::array<double, 2> tool_analog_input;
+  int32_t tool_output_voltage;
+  double tool_output_current;
+  double tool_temperature;
+  int32_t robot_mode;
+  int32_t safety_mode;
+  uint32_t robot_status_bits;
+  uint32_t safety_status_bits;
+  uint64_t actual_dig_in_bits;
+  uint64_t actual_dig_out_bits;
+  uint32_t analog_io_types;
+  uint32_t tool_analog_input_types;
+};
+
+// Decoding as it was done by the hardware interface before the binding table was introduced
+template <typename T>
+void readData(rtde::DataPackage& data_pkg, const std::string& var_name, T& data)
+{
+  if (!data_pkg.getData(var_name, data)) {
+    std::string error_msg = "Did not find '" + var_name + "' in data sent from robot. This should not happen!";
+    throw std::runtime_error(error_msg);
+  }
+}
+
+void decodeByName(rtde::DataPackage& data_pkg, DecodedState& s)
+{
+  readData(data_pkg, "actual_q", s.joint_positions);
+  readData(data_pkg, "actual_qd", s.joint_velocities);
+  readData(data_pkg, "actual_current", s.joint_efforts);
+  readData(data_pkg, "target_speed_fraction", s.target_speed_fraction);
+  readData(data_pkg, "speed_scaling", s.speed_scaling);
+  readData(data_pkg, "runtime_state", s.runtime_state);
+  readData(data_pkg, "actual_TCP_force", s.ft_sensor_measurements);
+  readData(data_pkg, "actual_TCP_pose", s.tcp_pose);
+  readData(data_pkg, "standard_analog_input0", s.standard_analog_input[0]);
+  readData(data_pkg, "standard_analog_input1", s.standard_analog_input[1]);
+  readData(data_pkg, "standard_analog_output0", s.standard_analog_output[0]);
+  readData(data_pkg, "standard_analog_output1", s.standard_analog_output[1]);
+  readData(data_pkg, "tool_mode", s.tool_mode);
+  readData(data_pkg, "tool_analog_input0", s.tool_analog_input[0]);
+  readData(data_pkg, "tool_analog_input1", s.tool_analog_input[1]);
+  readData(data_pkg, "tool_output_voltage", s.tool_output_voltage);
+  readData(data_pkg, "tool_output_current", s.tool_output_current);
+  readData(data_pkg, "tool_temperature", s.tool_temperature);
+  readData(data_pkg, "robot_mode", s.robot_mode);
+  readData(data_pkg, "safety_mode", s.safety_mode);
+  readData(data_pkg, "robot_status_bits", s.robot_status_bits);
+  readData(data_pkg, "safety_status_bits", s.safety_status_bits);
+  readData(data_pkg, "actual_digital_input_bits", s.actual_dig_in_bits);
+  readData(data_pkg, "actual_digital_output_bits", s.actual_dig_out_bits);
+  readData(data_pkg, "analog_io_types", s.analog_io_types);
+  readData(data_pkg, "tool_analog_input_types", s.tool_analog_input_types);
+}
+
+void bindState(ur_robot_driver::RTDEOutputBinding& binding, DecodedState& s)
+{
+  binding.bind("actual_q", &s.joint_positions);
+  binding.bind("actual_qd", &s.joint_velocities);
+  binding.bind("actual_current", &s.joint_efforts);
+  binding.bind("target_speed_fraction", &s.target_speed_fraction);
+  binding.bind("speed_scaling", &s.speed_scaling);
+  binding.bind("runtime_state", &s.runtime_state);
+  binding.bind("actual_TCP_force", &s.ft_sensor_measurements);
+  binding.bind("actual_TCP_pose", &s.tcp_pose);
+  binding.bind("standard_analog_input0", &s.standard_analog_input[0]);
+  binding.bind("standard_analog_input1", &s.standard_analog_input[1]);
+  binding.bind("standard_analog_output0", &s.standard_analog_output[0]);
+  binding.bind("standard_analog_output1", &s.standard_analog_output[1]);
+  binding.bind("tool_mode", &s.tool_mode);
+  binding.bind("tool_analog_input0", &s.tool_analog_input[0]);
+  binding.bind("tool_analog_input1", &s.tool_analog_input[1]);
+  binding.bind("tool_output_voltage", &s.tool_output_voltage);
+  binding.bind("tool_output_current", &s.tool_output_current);
+  binding.bind("tool_temperature", &s.tool_temperature);
+  binding.bind("robot_mode", &s.robot_mode);
+  binding.bind("safety_mode", &s.safety_mode);
+  binding.bind("robot_status_bits", &s.robot_status_bits);
+  binding.bind("safety_status_bits", &s.safety_status_bits);
+  binding.bind("actual_digital_input_bits", &s.actual_dig_in_bits);
+  binding.bind("actual_digital_output_bits", &s.actual_dig_out_bits);
+  binding.bind("analog_io_types", &s.analog_io_types);
+  binding.bind("tool_analog_input_types", &s.tool_analog_input_types);
+}
+
+template <typename F>
+double nanosecondsPerCycle(F&& decode, size_t iterations)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < iterations; ++i) {
+    decode();
+  }
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(iterations);
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  const std::string recipe_file = argc > 1 ? argv[1] : std::string(RESOURCES_DIR) + "/rtde_output_recipe.txt";
+  const size_t iterations = argc > 2 ? std::stoul(argv[2]) : 1000000;
+
+  rtde::DataPackage data_pkg(ur_robot_driver::RTDEOutputBinding::readRecipe(recipe_file));
+  data_pkg.initEmpty();
+
+  DecodedState state;
+  ur_robot_driver::RTDEOutputBinding binding;
+  bindState(binding, state);
+
+  // warm up caches before measuring
+  nanosecondsPerCycle([&]() { decodeByName(data_pkg, state); }, iterations / 10);
+  nanosecondsPerCycle([&]() { binding.decode(data_pkg); }, iterations / 10);
+
+  const double by_name = nanosecondsPerCycle([&]() { decodeByName(data_pkg, state); }, iterations);
+  const double by_binding = nanosecondsPerCycle([&]() { binding.decode(data_pkg); }, iterations);
+
+  std::cout << "Decoding " << binding.size() << " fields, " << iterations << " iterations" << std::endl;
+  std::cout << "  lookup by name:      " << by_name << " ns/cycle" << std::endl;
+  std::cout << "  binding table:       " << by_binding << " ns/cycle" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,129 @@
+// Copyright 2026 FZI Forschungszentrum Informatik
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-16
+ *
+ * Micro-benchmark for the per-cycle cost of rotating the TCP wrench into the tool frame. Usage:
+ *
+ *   wrench_transform_benchmark [iterations]
+ */
+//----------------------------------------------------------------------
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+#include "geometry_msgs/msg/transform_stamped.hpp"
+#include "tf2_geometry_msgs/tf2_geometry_msgs.h"
+
+#include "ur_robot_driver/wrench_transform.hpp"
+
+namespace
+{
+// Transformation as it was done by the hardware interface before, see extractToolPose() and
+// transformForceTorque() in earlier versions
+void transformWithTf2(const urcl::vector6d_t& tcp_pose, urcl::vector6d_t& wrench,
+                      geometry_msgs::msg::TransformStamped& tcp_transform)
+{
+  double tcp_angle = std::sqrt(std::pow(tcp_pose[3], 2) + std::pow(tcp_pose[4], 2) + std::pow(tcp_pose[5], 2));
+
+  tf2::Vector3 rotation_vec(tcp_pose[3], tcp_pose[4], tcp_pose[5]);
+  tf2::Quaternion rotation;
+  if (tcp_angle > 1e-16) {
+    rotation.setRotation(rotation_vec.normalized(), tcp_angle);
+  } else {
+    rotation.setValue(0.0, 0.0, 0.0, 1.0);
+  }
+  tcp_transform.transform.translation.x = tcp_pose[0];
+  tcp_transform.transform.translation.y = tcp_pose[1];
+  tcp_transform.transform.translation.z = tcp_pose[2];
+  tcp_transform.transform.rotation = tf2::toMsg(rotation);
+
+  tf2::Vector3 tcp_force(wrench[0], wrench[1], wrench[2]);
+  tf2::Vector3 tcp_torque(wrench[3], wrench[4], wrench[5]);
+
+  tf2::Quaternion rotation_quat;
+  tf2::fromMsg(tcp_transform.transform.rotation, rotation_quat);
+  tcp_force = tf2::quatRotate(rotation_quat.inverse(), tcp_force);
+  tcp_torque = tf2::quatRotate(rotation_quat.inverse(), tcp_torque);
+
+  wrench = { tcp_force.x(), tcp_force.y(), tcp_force.z(), tcp_torque.x(), tcp_torque.y(), tcp_torque.z() };
+}
+
+template <typename F>
+double nanosecondsPerCycle(F&& transform, size_t iterations)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < iterations; ++i) {
+    transform();
+  }
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(iterations);
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  const size_t iterations = argc > 1 ? std::stoul(argv[1]) : 1000000;
+
+  const urcl::vector6d_t tcp_pose = { 0.3, -0.2, 0.5, 1.2, -0.4, 2.1 };
+  const urcl::vector6d_t measured_wrench = { 1.0, -2.0, 9.81, 0.1, 0.2, -0.3 };
+  geometry_msgs::msg::TransformStamped tcp_transform;
+
+  // both paths have to agree before their cost is compared
+  urcl::vector6d_t tf2_wrench = measured_wrench;
+  urcl::vector6d_t eigen_wrench = measured_wrench;
+  transformWithTf2(tcp_pose, tf2_wrench, tcp_transform);
+  ur_robot_driver::transformWrenchToTool(tcp_pose, eigen_wrench);
+  double max_deviation = 0.0;
+  for (size_t i = 0; i < 6; ++i) {
+    max_deviation = std::max(max_deviation, std::abs(tf2_wrench[i] - eigen_wrench[i]));
+  }
+  if (max_deviation > 1e-9) {
+    std::cerr << "Transformations disagree by " << max_deviation << std::endl;
+    return 1;
+  }
+
+  // The wrench is reset in every iteration, so both paths rotate the same input. The volatile sink
+  // keeps the compiler from dropping the computation.
+  volatile double sink = 0.0;
+  auto tf2_cycle = [&]() {
+    urcl::vector6d_t wrench = measured_wrench;
+    transformWithTf2(tcp_pose, wrench, tcp_transform);
+    sink = wrench[0];
+  };
+  auto eigen_cycle = [&]() {
+    urcl::vector6d_t wrench = measured_wrench;
+    ur_robot_driver::transformWrenchToTool(tcp_pose, wrench);
+    sink = wrench[0];
+  };
+
+  // warm up caches before measuring
+  nanosecondsPerCycle(tf2_cycle, iterations / 10);
+  nanosecondsPerCycle(eigen_cycle, iterations / 10);
+
+  const double with_tf2 = nanosecondsPerCycle(tf2_cycle, iterations);
+  const double with_eigen = nanosecondsPerCycle(eigen_cycle, iterations);
+
+  std::cout << "Rotating the TCP wrench, " << iterations << " iterations" << std::endl;
+  std::cout << "  tf2 quaternions:     " << with_tf2 << " ns/cycle" << std::endl;
+  std::cout << "  Eigen matrix:        " << with_eigen << " ns/cycle" << std::endl;
+  (void)sink;
+
+  return 0;
+}
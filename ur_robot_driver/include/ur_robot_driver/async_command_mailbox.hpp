@@ -0,0 +1,214 @@
+// Copyright 2026 FZI Forschungszentrum Informatik
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef UR_ROBOT_DRIVER__ASYNC_COMMAND_MAILBOX_HPP_
+#define UR_ROBOT_DRIVER__ASYNC_COMMAND_MAILBOX_HPP_
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+#include "ur_robot_driver/spsc_queue.hpp"
+
+namespace ur_robot_driver
+{
+/*!
+ * \brief Request for the robot that is too slow to be sent from the control thread, e.g. setting an
+ * output or the payload.
+ */
+struct AsyncCommand
+{
+  enum class Type
+  {
+    SET_OUTPUTS,
+    SPEED_SLIDER,
+    RESEND_ROBOT_PROGRAM,
+    SET_PAYLOAD,
+    SET_PAYLOAD_REGISTERS
+  };
+
+  Type type;
+  // Digital outputs to set, numbered like the GPIO interfaces: standard outputs 0-7, configurable
+  // outputs 8-15 and tool outputs 16-17. Each of them is still written with an RTDE package of its own.
+  uint32_t digital_output_mask;
+  uint32_t digital_output_bits;
+  // Analog outputs and speed slider in the first values, NaN for analog outputs that do not change.
+  // Mass and center of gravity of the payload.
+  std::array<double, 4> values;
+  // sequence number the robot program echoes once it applied the payload registers
+  int32_t seq;
+};
+
+/*!
+ * \brief Outcome of an AsyncCommand.
+ */
+struct AsyncCommandResult
+{
+  AsyncCommand::Type type;
+  bool success;
+};
+
+/*!
+ * \brief Number of general purpose input registers RTDE clients may write, the bit registers 64 to 127
+ * and the int and double registers 24 to 47.
+ */
+constexpr size_t MAX_REGISTER_COMMANDS = 64 + 24 + 24;
+
+/*!
+ * \brief Values of input registers the control thread streams to the robot program. Every update
+ * carries all values, so the worker only sends the newest one and skips those queued before it.
+ */
+struct StreamedRegisters
+{
+  // the worker forgets what it sent so far and sends all values again, e.g. after a reconnect
+  bool resend;
+  // task frame, wrench and limits of force mode in the order of the double registers
+  std::array<double, 18> force_mode_values;
+  // compliant axes of force mode as bit mask
+  int32_t force_mode_selection;
+  // force mode type, 0 switches force mode off
+  int32_t force_mode_type;
+  // sequence number of the command written last, 0 before the first one
+  int32_t command_seq;
+  // general purpose input registers in the order of the "rtde" command interfaces, NaN while a
+  // register was not commanded yet
+  std::array<double, MAX_REGISTER_COMMANDS> register_values;
+  // servoj parameters, NaN if they are not changed at runtime
+  double servoj_gain;
+  double servoj_lookahead_time;
+};
+
+/*!
+ * \brief Sequence number the worker sent to the robot program and when it started sending it.
+ */
+struct SentSequence
+{
+  enum class Type
+  {
+    COMMAND,
+    LATENCY_PROBE
+  };
+
+  Type type;
+  int32_t seq;
+  std::chrono::steady_clock::time_point send_time;
+  // write cycle of the control thread the number was sent in, only counted for the latency probe
+  uint64_t write_cycle;
+};
+
+/*!
+ * \brief Passes asynchronous commands and streamed register values from the control thread to a
+ * worker thread and the results of the commands and the sent sequence numbers back.
+ *
+ * Both directions are bounded lock-free queues, so the control thread never blocks or allocates.
+ * Posting a command wakes the worker through an eventfd, so the command is dispatched right away
+ * instead of with the next polling pass.
+ */
+class AsyncCommandMailbox
+{
+public:
+  static constexpr size_t CAPACITY = 32;
+
+  AsyncCommandMailbox();
+  ~AsyncCommandMailbox();
+
+  AsyncCommandMailbox(const AsyncCommandMailbox&) = delete;
+  AsyncCommandMailbox& operator=(const AsyncCommandMailbox&) = delete;
+
+  /*!
+   * \brief Queues a command and wakes the worker. Called from the control thread.
+   *
+   * \returns False if the queue is full
+   */
+  bool postCommand(const AsyncCommand& command);
+
+  /*!
+   * \brief Queues new values of the streamed registers and wakes the worker. Called from the control
+   * thread.
+   *
+   * \returns False if the queue is full
+   */
+  bool postRegisters(const StreamedRegisters& registers);
+
+  /*!
+   * \brief Takes the oldest queued values of the streamed registers. Called from the worker thread.
+   *
+   * \returns False if there are no values
+   */
+  bool takeRegisters(StreamedRegisters& registers);
+
+  /*!
+   * \brief Reports a sequence number that was sent to the robot program. Called from the worker
+   * thread.
+   *
+   * \returns False if the queue is full
+   */
+  bool postSentSequence(const SentSequence& sequence);
+
+  /*!
+   * \brief Takes the oldest reported sequence number. Called from the control thread.
+   *
+   * \returns False if there is none
+   */
+  bool takeSentSequence(SentSequence& sequence);
+
+  /*!
+   * \brief Takes the oldest queued command. Called from the worker thread.
+   *
+   * \returns False if there is no command
+   */
+  bool takeCommand(AsyncCommand& command);
+
+  /*!
+   * \brief Queues the result of a command. Called from the worker thread.
+   *
+   * \returns False if the queue is full
+   */
+  bool postResult(const AsyncCommandResult& result);
+
+  /*!
+   * \brief Takes the oldest result. Called from the control thread.
+   *
+   * \returns False if there is no result
+   */
+  bool takeResult(AsyncCommandResult& result);
+
+  /*!
+   * \brief Blocks the worker thread until a command is posted, wake() is called or the timeout
+   * expires.
+   */
+  void wait(std::chrono::milliseconds timeout);
+
+  /*!
+   * \brief Wakes the worker thread without posting a command, e.g. to shut it down.
+   */
+  void wake();
+
+private:
+  SPSCQueue<AsyncCommand, CAPACITY> commands_;
+  SPSCQueue<AsyncCommandResult, CAPACITY> results_;
+  SPSCQueue<StreamedRegisters, CAPACITY> registers_;
+  SPSCQueue<SentSequence, CAPACITY> sent_sequences_;
+  int event_fd_;
+};
+}  // namespace ur_robot_driver
+
+#endif  // UR_ROBOT_DRIVER__ASYNC_COMMAND_MAILBOX_HPP_
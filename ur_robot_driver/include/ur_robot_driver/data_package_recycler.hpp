@@ -0,0 +1,79 @@
+// Copyright 2026 FZI Forschungszentrum Informatik
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef UR_ROBOT_DRIVER__DATA_PACKAGE_RECYCLER_HPP_
+#define UR_ROBOT_DRIVER__DATA_PACKAGE_RECYCLER_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "ur_client_library/rtde/data_package.h"
+#include "ur_robot_driver/spsc_queue.hpp"
+
+namespace ur_robot_driver
+{
+/*!
+ * \brief Moves the release of decoded RTDE data packages out of the control thread.
+ *
+ * The client library hands out every data package as a freshly allocated object. Destroying it
+ * frees the package and all of its per-field storage. The control thread hands decoded packages to
+ * a preallocated ring instead, and a non real-time thread releases them in batches. The control
+ * thread only frees a package itself if the ring is full, which is counted.
+ */
+class DataPackageRecycler
+{
+public:
+  static constexpr size_t CAPACITY = 64;
+
+  DataPackageRecycler();
+
+  /*!
+   * \brief Hands a decoded package over for release. Called from the control thread.
+   *
+   * \param data_pkg Package that is no longer needed
+   */
+  void recycle(std::unique_ptr<urcl::rtde_interface::DataPackage> data_pkg);
+
+  /*!
+   * \brief Releases all packages handed over so far. Called from a non real-time thread.
+   *
+   * \returns Number of released packages
+   */
+  size_t drain();
+
+  /*!
+   * \brief Number of heap operations on packages the control thread performed itself. The client
+   * library constructs every package on its producer thread, so this only counts packages released
+   * on the control thread because the ring was full. It stays at zero in steady state.
+   */
+  uint64_t getControlThreadAllocations() const
+  {
+    return control_thread_allocations_.load(std::memory_order_relaxed);
+  }
+
+private:
+  SPSCQueue<std::unique_ptr<urcl::rtde_interface::DataPackage>, CAPACITY> ring_;
+  std::atomic<uint64_t> control_thread_allocations_;
+};
+}  // namespace ur_robot_driver
+
+#endif  // UR_ROBOT_DRIVER__DATA_PACKAGE_RECYCLER_HPP_
@@ -26,6 +26,10 @@
 #define UR_ROBOT_DRIVER__HARDWARE_INTERFACE_HPP_
 
 // System
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -39,17 +43,36 @@
 
 // UR stuff
 #include "ur_client_library/ur/ur_driver.h"
+#include "ur_client_library/rtde/rtde_client.h"
+#include "ur_robot_driver/async_command_mailbox.hpp"
 #include "ur_robot_driver/dashboard_client_ros.hpp"
+#include "ur_robot_driver/data_package_recycler.hpp"
+#include "ur_robot_driver/latency_histogram.hpp"
+#include "ur_robot_driver/rtde_output_binding.hpp"
+#include "ur_robot_driver/rtde_packet_statistics.hpp"
+#include "ur_robot_driver/trajectory_forwarder.hpp"
+#include "ur_robot_driver/wrench_transform.hpp"
 #include "ur_dashboard_msgs/msg/robot_mode.hpp"
 
 // ROS
 #include "rclcpp/macros.hpp"
 #include "rclcpp_lifecycle/state.hpp"
-#include "geometry_msgs/msg/transform_stamped.hpp"
-#include "tf2_geometry_msgs/tf2_geometry_msgs.h"
 
 namespace ur_robot_driver
 {
+/*!
+ * \brief State of the connection to the robot. The control thread detects a lost connection and
+ * the async thread re-establishes it.
+ */
+enum class ConnectionState
+{
+  DISCONNECTED,
+  CONNECTED,
+  LOST,
+  RECONNECTING,
+  RESYNCING
+};
+
 enum class PausingState
 {
   PAUSED,
@@ -57,6 +80,17 @@ enum class PausingState
   RAMPUP
 };
 
+/*!
+ * \brief How the robot program continues the servo motion when a setpoint is late. Values match the
+ * constants of the URScript.
+ */
+enum class ServoExtrapolationMode
+{
+  HOLD = 0,
+  LINEAR = 1,
+  QUADRATIC = 2
+};
+
 enum StoppingInterface
 {
   NONE,
@@ -76,12 +110,17 @@ class URPositionHardwareInterface : public hardware_interface::SystemInterface
 public:
   RCLCPP_SHARED_PTR_DEFINITIONS(URPositionHardwareInterface);
 
+  ~URPositionHardwareInterface() override;
+
   CallbackReturn on_init(const hardware_interface::HardwareInfo& system_info) final;
 
   std::vector<hardware_interface::StateInterface> export_state_interfaces() final;
 
   std::vector<hardware_interface::CommandInterface> export_command_interfaces() final;
 
+  CallbackReturn on_configure(const rclcpp_lifecycle::State& previous_state) final;
+  CallbackReturn on_cleanup(const rclcpp_lifecycle::State& previous_state) final;
+  CallbackReturn on_shutdown(const rclcpp_lifecycle::State& previous_state) final;
   CallbackReturn on_activate(const rclcpp_lifecycle::State& previous_state) final;
   CallbackReturn on_deactivate(const rclcpp_lifecycle::State& previous_state) final;
 
@@ -106,23 +145,342 @@ public:
 
   void asyncThread();
 
+  /*!
+   * \brief Receives the packages of the low-rate RTDE connection and hands them to the control
+   * thread. Runs until the hardware interface is deactivated.
+   */
+  void slowRTDEThread();
+
 protected:
-  template <typename T>
-  void readData(const std::unique_ptr<urcl::rtde_interface::DataPackage>& data_pkg, const std::string& var_name,
-                T& data);
-  template <typename T, size_t N>
-  void readBitsetData(const std::unique_ptr<urcl::rtde_interface::DataPackage>& data_pkg, const std::string& var_name,
-                      std::bitset<N>& data);
+  /*!
+   * \brief Builds the tables decoding RTDE output fields into the member variables. Fields without a
+   * dedicated member are decoded into generic fields, which are exported under the "rtde" component.
+   *
+   * \param output_recipe Fields of the RTDE output recipe in recipe order
+   * \param slow_output_recipe Fields streamed on the low-rate RTDE connection, empty if there is none
+   *
+   * \returns False if a field required by the hardware interface is missing in the output recipe, if
+   * a recipe contains an unknown field or if a field is part of both recipes
+   */
+  bool bindOutputRecipe(const std::vector<std::string>& output_recipe,
+                        const std::vector<std::string>& slow_output_recipe);
+
+  /*!
+   * \brief Adds a single RTDE output field to a decoding table.
+   *
+   * \param field Name of the RTDE output field
+   * \param binding Table to add the field to
+   * \param generic_fields Receives a generic field if there is no dedicated member for the field
+   *
+   * \returns False if the field is unknown
+   */
+  bool bindOutputField(const std::string& field, RTDEOutputBinding& binding,
+                       std::vector<std::unique_ptr<GenericRTDEField>>& generic_fields);
+
+  /*!
+   * \brief Checks whether an RTDE output field is streamed on any of the RTDE connections.
+   */
+  bool isOutputFieldStreamed(const std::string& field) const;
+
+  /*!
+   * \brief Checks whether an RTDE output field is one of the registers reporting the command tracking.
+   */
+  bool isCommandTrackingField(const std::string& field) const;
+
+  /*!
+   * \brief Decodes the latest package of the low-rate RTDE connection, if one arrived since the last
+   * call. Called from the control thread.
+   */
+  void readSlowOutputs();
+
+  /*!
+   * \brief Fetches the next RTDE data package. In non-blocking mode, this polls the connection until
+   * a package arrives or the read budget is used up.
+   *
+   * \returns The package or a nullptr if none arrived in time
+   */
+  std::unique_ptr<urcl::rtde_interface::DataPackage> fetchDataPackage();
+
+  /*!
+   * \brief Resets the bridging of stale cycles to the currently active commands. Has to be called
+   * whenever the commands are reset, e.g. on a controller switch.
+   */
+  void resetStaleCommands();
+
+  /*!
+   * \brief Sends the commands for a cycle without new robot state, to keep the reverse connection
+   * alive. Depending on the configuration the last commands are held or extrapolated.
+   */
+  void writeStaleCommands();
+
+  /*!
+   * \brief Creates the driver and, if configured, the low-rate RTDE connection from the hardware
+   * parameters.
+   *
+   * \returns False if connecting to the robot failed
+   */
+  bool connectToRobot();
+
+  /*!
+   * \brief Starts streaming RTDE packages on all connections created by connectToRobot().
+   */
+  void startRobotCommunication();
+
+  /*!
+   * \brief Stops the low-rate RTDE connection and destroys the driver.
+   */
+  void disconnectFromRobot();
+
+  /*!
+   * \brief Replaces a lost connection to the robot by a new one. Retries with increasing waiting
+   * times until it succeeds or the hardware interface is deactivated. Called from the async thread.
+   */
+  void reconnectToRobot();
+
+  /*!
+   * \brief Connects to the robot and starts the async thread. Called on activation or, with warm
+   * standby, on configuration.
+   */
+  CallbackReturn startDriver();
+
+  /*!
+   * \brief Stops the async thread and closes all connections to the robot.
+   */
+  void stopDriver();
+
+  /*!
+   * \brief Keeps the robot program alive while the hardware interface is in warm standby. Called
+   * from read(), as write() is only called while the hardware interface is active.
+   */
+  void writeStandby();
+
+  /*!
+   * \brief Sets up the low-rate RTDE connection. Runs concurrently to the construction of the driver.
+   *
+   * \param robot_ip IP address of the robot
+   *
+   * \returns False if the connection could not be initialized
+   */
+  bool connectSlowRTDE(const std::string& robot_ip);
+
+  /*!
+   * \brief Creates the private directory for the generated script and recipes unless it exists
+   * already. The directory is only accessible by the user running the driver, so nobody else can
+   * place files or links with the names the driver writes to.
+   *
+   * \returns False if the directory could not be created
+   */
+  bool prepareGeneratedFilesDirectory();
+
+  /*!
+   * \brief Replaces the placeholders of the URScript the client library does not know about and
+   * stores the result in the directory of the generated files. Within the lifetime of this hardware
+   * interface the file is only written again if the template or one of the replaced values changed.
+   *
+   * \param script_filename Path to the URScript template
+   * \param prepared_filename Receives the path of the prepared script
+   * \param cached Set to true if the script prepared before was still valid
+   *
+   * \returns False if the script could not be read or written
+   */
+  bool prepareScript(const std::string& script_filename, std::string& prepared_filename, bool& cached);
+
+  /*!
+   * \brief Stores an RTDE recipe in the directory of the generated files, so it can be passed to the
+   * client library. Within the lifetime of this hardware interface the file is only written again if
+   * the recipe changed.
+   *
+   * \param recipe Fields of the recipe
+   * \param recipe_name Name of the recipe, e.g. "output"
+   * \param recipe_filename Receives the path of the recipe file
+   *
+   * \returns False if the file could not be written
+   */
+  bool writeRecipe(const std::vector<std::string>& recipe, const std::string& recipe_name,
+                   std::string& recipe_filename);
+
+  /*!
+   * \brief Copies the general purpose input registers commanded by the controllers into the streamed
+   * registers.
+   */
+  void writeRegisterCommands();
+
+  /*!
+   * \brief Sends the general purpose input registers that changed since they were sent last. Called
+   * from the async thread.
+   */
+  void sendRegisterCommands(const StreamedRegisters& registers);
+
+  /*!
+   * \brief Makes the async thread send all register values again, e.g. after a reconnect.
+   */
+  void resendRegisterCommands();
+
+  /*!
+   * \brief Sends the next sequence number of the latency probe to the robot once the probe period
+   * elapsed. Called from the async thread.
+   */
+  void sendLatencyProbe();
+
+  /*!
+   * \brief Matches the sequence number echoed by the robot with the time it was sent.
+   *
+   * \param now Time the current package was received
+   */
+  void readLatencyProbe(std::chrono::steady_clock::time_point now);
+
+  /*!
+   * \brief Numbers the command written in this cycle and hands the number to the async thread with
+   * the streamed registers.
+   */
+  void writeCommandSequence();
+
+  /*!
+   * \brief Records the sequence numbers the async thread sent, so their echoes can be matched.
+   * Called from the control thread.
+   */
+  void collectSentSequences();
+
+  /*!
+   * \brief Evaluates which command the robot executes and how it handled the commands so far.
+   *
+   * \param now Time the current package was received
+   */
+  void readCommandTracking(std::chrono::steady_clock::time_point now);
+
+  /*!
+   * \brief Sends the requested payload through the payload registers to the robot program. Called
+   * from the async thread.
+   *
+   * \returns False if a register could not be sent
+   */
+  bool writePayload(const AsyncCommand& command);
+
+  /*!
+   * \brief Checks whether the robot program confirmed the payload sent last.
+   *
+   * \param now Time the current package was received
+   */
+  void readPayloadConfirmation(std::chrono::steady_clock::time_point now);
+
+  /*!
+   * \brief Takes over new servoj parameters from the command interfaces into the streamed registers.
+   */
+  void writeServojParameters();
+
+  /*!
+   * \brief Sends the servoj parameters that changed since they were sent last. Called from the async
+   * thread.
+   */
+  void sendServojParameters(const StreamedRegisters& registers);
+
+  /*!
+   * \brief Records how long the last switch between command modes took, once the first command of
+   * the new mode was written.
+   */
+  void finishModeSwitch();
+
+  /*!
+   * \brief Copies the force mode parameters into the streamed registers. Called from the control
+   * thread.
+   */
+  void writeForceMode();
+
+  /*!
+   * \brief Hands the streamed registers to the async thread if they changed since they were posted
+   * last. Called from the control thread.
+   */
+  void postStreamedRegisters();
+
+  /*!
+   * \brief Takes over the newest streamed registers posted by the control thread and sends the values
+   * that changed to the robot program. Called from the async thread.
+   */
+  void sendStreamedRegisters();
+
+  /*!
+   * \brief Sends the force mode parameters that changed since they were sent last. The force mode
+   * type goes last, as it switches force mode on and off. Called from the async thread.
+   */
+  void sendForceMode(const StreamedRegisters& registers);
+
+  /*!
+   * \brief Sends the sequence number of the command written last if it changed and reports it back
+   * to the control thread once it was sent. Called from the async thread.
+   */
+  void sendCommandSequence(const StreamedRegisters& registers);
+
+  /*!
+   * \brief Evaluates the jitter and the tracking error of the position commands and adjusts the
+   * servoj lookahead time after every evaluation window. The tracking error is measured against the
+   * command of one lookahead time ago, as servoj lags behind the commands by about that much.
+   */
+  void adaptServojLookahead();
+
+  /*!
+   * \brief Hands the next point of a forwarded trajectory to the robot program and tells it whether
+   * to cancel the trajectory it executes.
+   */
+  void writeTrajectoryForwarding();
+
+  /*!
+   * \brief Evaluates the progress reports of the robot program on forwarded trajectories.
+   */
+  void readTrajectoryReports();
+
+  /*!
+   * \brief Ends the forwarded trajectory with the given result.
+   */
+  void finishTrajectory(TrajectoryResult result);
 
   void initAsyncIO();
-  void checkAsyncIO();
+
+  /*!
+   * \brief Moves the requests the controllers wrote into the asynchronous command interfaces to the
+   * async thread. Called from the control thread.
+   */
+  void dispatchAsyncCommands();
+
+  /*!
+   * \brief Writes the results of finished asynchronous commands into the success interfaces. Called
+   * from the control thread.
+   */
+  void collectAsyncResults();
+
+  /*!
+   * \brief Executes all dispatched asynchronous commands. Called from the async thread.
+   */
+  void processAsyncCommands();
+
+  /*!
+   * \brief Sends a single asynchronous command to the robot.
+   *
+   * \returns True if the robot accepted the command
+   */
+  bool executeAsyncCommand(const AsyncCommand& command);
+
+  /*!
+   * \brief Hands the result of an asynchronous command back to the control thread.
+   */
+  void postAsyncResult(AsyncCommand::Type type, bool success);
+
+  /*!
+   * \brief Sets all outputs contained in a SET_OUTPUTS command.
+   *
+   * Merging the requests only reduces the number of commands and writes per output. The writer of the
+   * client library has no masked write for several outputs, so every changed output still costs an
+   * RTDE package of its own.
+   *
+   * \returns True if all outputs were set
+   */
+  bool writeOutputs(const AsyncCommand& command);
   void updateNonDoubleValues();
-  void extractToolPose();
-  void transformForceTorque();
 
   urcl::vector6d_t urcl_position_commands_;
   urcl::vector6d_t urcl_position_commands_old_;
   urcl::vector6d_t urcl_velocity_commands_;
+  // TCP velocity [vx, vy, vz, wx, wy, wz] in the base frame of the robot, executed with speedl
+  urcl::vector6d_t urcl_twist_commands_;
   urcl::vector6d_t urcl_joint_positions_;
   urcl::vector6d_t urcl_joint_velocities_;
   urcl::vector6d_t urcl_joint_efforts_;
@@ -131,16 +489,19 @@ protected:
 
   bool packet_read_;
 
+  // controller time in seconds as reported by the robot
+  double robot_timestamp_;
+
   uint32_t runtime_state_;
   bool controllers_initialized_;
 
-  std::bitset<18> actual_dig_out_bits_;
-  std::bitset<18> actual_dig_in_bits_;
+  uint64_t actual_dig_out_bits_;
+  uint64_t actual_dig_in_bits_;
   std::array<double, 2> standard_analog_input_;
   std::array<double, 2> standard_analog_output_;
-  std::bitset<4> analog_io_types_;
+  uint32_t analog_io_types_;
   uint32_t tool_mode_;
-  std::bitset<2> tool_analog_input_types_;
+  uint32_t tool_analog_input_types_;
   std::array<double, 2> tool_analog_input_;
   int32_t tool_output_voltage_;
   double tool_output_current_;
@@ -150,13 +511,65 @@ protected:
   double speed_scaling_combined_;
   int32_t robot_mode_;
   int32_t safety_mode_;
-  std::bitset<4> robot_status_bits_;
-  std::bitset<11> safety_status_bits_;
-
-  // transform stuff
-  tf2::Vector3 tcp_force_;
-  tf2::Vector3 tcp_torque_;
-  geometry_msgs::msg::TransformStamped tcp_transform_;
+  uint32_t robot_status_bits_;
+  uint32_t safety_status_bits_;
+
+  // recipes passed to the client library, the recipe files extended by the registers in use
+  std::vector<std::string> output_recipe_;
+  std::vector<std::string> input_recipe_;
+
+  // general purpose input registers written through the "rtde" command interfaces
+  struct RegisterCommand
+  {
+    std::string name;
+    RTDEFieldType type;
+    uint32_t index;
+    double command;
+  };
+  std::vector<RegisterCommand> register_commands_;
+  // values the async thread sent last, NaN if a value has to be sent again
+  std::array<double, MAX_REGISTER_COMMANDS> register_values_sent_;
+
+  // decoding table for the RTDE output recipe
+  RTDEOutputBinding output_binding_;
+  std::vector<std::unique_ptr<GenericRTDEField>> generic_output_fields_;
+  bool tcp_pose_in_recipe_;
+  bool tcp_force_in_recipe_;
+  // the wrench is only rotated into the tool frame if the force torque sensor is exported
+  bool transform_wrench_;
+
+  // Private directory of the generated files, removed with the hardware interface. The inputs the
+  // files were written from are only kept in memory, so a reconnect or a new activation reuses files
+  // whose inputs did not change, but a restarted driver writes them again.
+  std::string generated_files_directory_;
+  std::string prepared_script_key_;
+  std::map<std::string, std::string> written_recipes_;
+
+  // low-rate RTDE connection for slowly changing fields
+  std::string slow_output_recipe_filename_;
+  std::string slow_input_recipe_filename_;
+  double slow_output_frequency_;
+  RTDEOutputBinding slow_output_binding_;
+  std::vector<std::unique_ptr<GenericRTDEField>> generic_slow_output_fields_;
+  urcl::comm::INotifier slow_rtde_notifier_;
+  std::unique_ptr<urcl::rtde_interface::RTDEClient> slow_rtde_client_;
+  SPSCQueue<std::unique_ptr<urcl::rtde_interface::DataPackage>, 4> slow_packages_;
+  std::shared_ptr<std::thread> slow_rtde_thread_;
+  std::atomic<bool> slow_rtde_thread_shutdown_;
+
+  // gap and loss detection based on the RTDE timestamps
+  bool timestamp_in_recipe_;
+  RTDEPacketStatistics packet_statistics_;
+  uint64_t reported_missed_packets_;
+  double rtde_received_packets_;
+  double rtde_missed_packets_;
+  double rtde_late_packets_;
+  double rtde_duplicate_packets_;
+  double rtde_max_gap_;
+
+  // decoded packages are released by the async thread
+  DataPackageRecycler package_recycler_;
+  double rtde_package_allocations_;
 
   // asynchronous commands
   std::array<double, 18> standard_dig_out_bits_cmd_;
@@ -170,12 +583,28 @@ protected:
   bool initialized_;
   double system_interface_initialized_;
   bool async_thread_shutdown_;
+  AsyncCommandMailbox async_mailbox_;
 
   // payload stuff
   urcl::vector3d_t payload_center_of_gravity_;
   double payload_mass_;
   double payload_async_success_;
 
+  // raw non double values of the last conversion, to convert only what changed
+  uint64_t last_actual_dig_out_bits_;
+  uint64_t last_actual_dig_in_bits_;
+  uint32_t last_analog_io_types_;
+  uint32_t last_tool_mode_;
+  uint32_t last_tool_analog_input_types_;
+  int32_t last_tool_output_voltage_;
+  int32_t last_robot_mode_;
+  int32_t last_safety_mode_;
+  uint32_t last_robot_status_bits_;
+  uint32_t last_safety_status_bits_;
+  bool non_double_values_converted_;
+  // incremented whenever any of the converted values changes
+  double gpio_change_seq_;
+
   // copy of non double values
   std::array<double, 18> actual_dig_out_bits_copy_;
   std::array<double, 18> actual_dig_in_bits_copy_;
@@ -191,6 +620,175 @@ protected:
   bool robot_program_running_;
   bool non_blocking_read_;
 
+  // deadline mode of non-blocking reads
+  std::chrono::duration<double> read_budget_;
+  bool extrapolate_stale_commands_;
+  urcl::vector6d_t position_command_step_;
+  urcl::vector6d_t urcl_velocity_commands_old_;
+  urcl::vector6d_t urcl_twist_commands_old_;
+  size_t stale_cycles_since_write_;
+  std::chrono::steady_clock::time_point last_command_write_time_;
+  double stale_cycles_;
+  double consecutive_stale_cycles_;
+
+  // reconnection to the robot without a lifecycle transition
+  std::atomic<ConnectionState> connection_state_;
+  std::chrono::duration<double> reconnect_timeout_;
+  std::chrono::steady_clock::time_point last_package_time_;
+  std::chrono::steady_clock::time_point connection_lost_time_;
+  double robot_connected_;
+  double reconnects_;
+  // time in seconds from the last package before a connection loss to the first one afterwards
+  double last_recovery_duration_;
+
+  // sequence number sent to the robot and when it was sent
+  struct SequenceSample
+  {
+    int32_t seq;
+    std::chrono::steady_clock::time_point send_time;
+    uint64_t write_cycle;
+  };
+
+  // round trip through the robot, measured by echoing sequence numbers in an integer register
+  int latency_probe_register_;
+  std::string latency_probe_output_field_;
+  int32_t latency_probe_echo_;
+  int32_t latency_probe_last_echo_;
+  // sequence number and send time of the latest probe, owned by the async thread
+  int32_t latency_probe_seq_;
+  std::chrono::steady_clock::time_point last_latency_probe_send_;
+  // counted by the control thread, read by the async thread when it sends a probe
+  std::atomic<uint64_t> latency_probe_write_cycles_;
+  std::array<SequenceSample, 64> latency_probe_samples_;
+  LatencyHistogram latency_probe_histogram_;
+  std::chrono::steady_clock::time_point last_latency_probe_evaluation_;
+  double latency_probe_round_trip_cycles_;
+  double latency_probe_round_trip_us_;
+  double latency_probe_p50_us_;
+  double latency_probe_p99_us_;
+  double latency_probe_max_us_;
+
+  // freshness of the commands executed by the robot, reported by the robot program in integer
+  // registers. The async thread sends the sequence number on RTDE next to the command on the reverse
+  // interface, so the robot may attribute it to a neighbouring command.
+  int command_tracking_register_;
+  std::vector<std::string> command_tracking_output_fields_;
+  std::array<int32_t, 4> command_tracking_outputs_;
+  int32_t command_seq_;
+  // sequence number the async thread sent last
+  int32_t command_seq_sent_;
+  std::array<SequenceSample, 64> command_samples_;
+  double command_age_cycles_;
+  double command_age_us_;
+  double robot_skipped_commands_;
+  double robot_extrapolated_steps_;
+  double robot_max_extrapolations_;
+
+  // latency of the last switch between command modes, from perform_command_mode_switch() to the first
+  // command written in the new mode and, with command tracking, to the robot executing it
+  bool mode_switch_pending_;
+  std::chrono::steady_clock::time_point mode_switch_time_;
+  uint64_t mode_switch_write_cycles_;
+  // first tracked command of the new mode, 0 once the robot executed it
+  int32_t mode_switch_seq_;
+  double mode_switch_cycles_;
+  double mode_switch_us_;
+  double mode_switch_robot_us_;
+
+  // payload set by the robot program from registers, confirmed by echoing a sequence number
+  int payload_register_;
+  std::string payload_output_field_;
+  int32_t payload_echo_;
+  int32_t payload_seq_;
+  bool payload_pending_;
+  std::chrono::steady_clock::time_point payload_send_time_;
+  double payload_applied_latency_us_;
+
+  // servoj parameters, changed at runtime through double registers
+  int servoj_parameter_register_;
+  double servoj_gain_;
+  double servoj_lookahead_time_;
+  double servoj_gain_cmd_;
+  double servoj_lookahead_time_cmd_;
+  // values the async thread sent last, NaN if they have to be sent again
+  double servoj_gain_sent_;
+  double servoj_lookahead_time_sent_;
+
+  // adaptation of the lookahead time to the jitter and the tracking error of the position commands
+  bool servoj_lookahead_adaptive_;
+  double servoj_lookahead_min_;
+  double servoj_lookahead_max_;
+  double servoj_tracking_error_tolerance_;
+  std::chrono::steady_clock::time_point servoj_adaptation_start_;
+  uint64_t servoj_adaptation_cycles_;
+  double servoj_adaptation_jitter_baseline_;
+  double servoj_adaptation_max_tracking_error_;
+  // position commands of the recent cycles, the tracking error is measured against the one the robot
+  // follows after the lookahead time
+  struct CommandSample
+  {
+    std::chrono::steady_clock::time_point time;
+    urcl::vector6d_t positions;
+  };
+  std::array<CommandSample, 256> servoj_command_history_;
+  size_t servoj_command_history_count_;
+  size_t servoj_command_history_next_;
+
+  // force mode applied by the robot program in every control step, set through registers
+  int force_mode_register_;
+  // pose of the task frame in the base frame of the robot
+  urcl::vector6d_t force_mode_task_frame_;
+  // axes of the task frame that are compliant, every value other than 0 selects the axis
+  urcl::vector6d_t force_mode_selection_;
+  // forces and torques applied along and around the compliant axes
+  urcl::vector6d_t force_mode_wrench_;
+  // maximum TCP speed along and around compliant axes and maximum deviation along and around the others
+  urcl::vector6d_t force_mode_limits_;
+  // type 1 to 3 as expected by force_mode
+  double force_mode_type_;
+  // values the async thread sent last, NaN or -1 if not sent yet
+  std::array<double, 18> force_mode_values_sent_;
+  int32_t force_mode_selection_sent_;
+  int32_t force_mode_type_sent_;
+  bool start_force_mode_;
+  bool stop_force_mode_;
+  bool force_mode_running_;
+
+  // Registers streamed to the robot program by the async thread, so the control thread never sends
+  // them itself. The control thread assembles them every cycle and posts them if they changed, the
+  // async thread keeps the newest ones it received.
+  StreamedRegisters streamed_registers_;
+  StreamedRegisters streamed_registers_posted_;
+  StreamedRegisters streamed_registers_received_;
+  bool streamed_registers_available_;
+
+  // extrapolation of late servo setpoints by the robot program
+  ServoExtrapolationMode servo_extrapolation_mode_;
+  int servo_extrapolation_max_steps_;
+  double servo_extrapolation_max_velocity_;
+  double servo_extrapolation_max_acceleration_;
+
+  // Trajectories executed by the robot program on its own. The controller hands the points over one
+  // at a time through the "trajectory_forwarding" command interfaces, the robot program reports its
+  // progress back through the trajectory socket.
+  int trajectory_port_;
+  TrajectoryForwarder trajectory_forwarder_;
+  urcl::vector6d_t trajectory_setpoint_positions_;
+  urcl::vector6d_t trajectory_setpoint_velocities_;
+  double trajectory_time_from_start_;
+  double trajectory_number_of_points_;
+  // 1 while a point waits to be taken over, reset to 0 by the hardware interface
+  double trajectory_transfer_state_;
+  double trajectory_abort_;
+  double trajectory_points_done_;
+  double trajectory_result_;
+  int32_t trajectory_id_;
+  int32_t trajectory_points_sent_;
+  int32_t trajectory_point_count_;
+  double trajectory_last_time_from_start_;
+  bool trajectory_active_;
+  bool trajectory_cancel_;
+
   PausingState pausing_state_;
   double pausing_ramp_up_increment_;
 
@@ -199,6 +797,17 @@ protected:
   std::vector<std::string> start_modes_;
   bool position_controller_running_;
   bool velocity_controller_running_;
+  bool start_twist_control_;
+  bool stop_twist_control_;
+  bool twist_controller_running_;
+  bool start_trajectory_forwarding_;
+  bool stop_trajectory_forwarding_;
+  bool trajectory_forwarding_running_;
+
+  // With warm standby the connection to the robot is set up on configuration and kept while the
+  // hardware interface is inactive, so activation only resumes commanding.
+  bool warm_standby_;
+  std::atomic<bool> standby_;
 
   std::unique_ptr<urcl::UrDriver> ur_driver_;
   std::shared_ptr<std::thread> async_thread_;
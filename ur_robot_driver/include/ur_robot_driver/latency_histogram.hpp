@@ -0,0 +1,175 @@
+// Copyright 2026 FZI Forschungszentrum Informatik
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef UR_ROBOT_DRIVER__LATENCY_HISTOGRAM_HPP_
+#define UR_ROBOT_DRIVER__LATENCY_HISTOGRAM_HPP_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace ur_robot_driver
+{
+/*!
+ * \brief Histogram of durations with a fixed relative precision, in the spirit of HdrHistogram.
+ *
+ * Every power of two range of nanoseconds is split into 16 equally wide buckets, so a recorded
+ * value is known to within about 6%. Durations of 2^31 ns (about 2 s) and more share the last
+ * bucket.
+ *
+ * record() must only be called from a single thread, usually the control thread. It neither
+ * allocates nor locks. snapshot() must only be called from a single other thread.
+ */
+class LatencyHistogram
+{
+public:
+  static constexpr size_t SUB_BUCKET_BITS = 4;
+  static constexpr size_t SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+  static constexpr size_t MAX_EXPONENT = 31;
+  static constexpr size_t BUCKETS = (MAX_EXPONENT - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+  /*!
+   * \brief Values recorded between two calls of snapshot().
+   */
+  struct Snapshot
+  {
+    std::array<uint64_t, BUCKETS> counts;
+    uint64_t count;
+    // largest value in nanoseconds, at least the lower bound of the highest bucket with a count
+    uint64_t max;
+
+    /*!
+     * \brief Value in nanoseconds that \p quantile of the recorded values do not exceed. Reports the
+     * upper bound of the bucket, i.e. errs towards longer durations.
+     *
+     * \param quantile Between 0 and 1, e.g. 0.99 for the 99th percentile
+     */
+    uint64_t percentile(double quantile) const
+    {
+      if (count == 0) {
+        return 0;
+      }
+      const uint64_t target = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(quantile * count)));
+      uint64_t cumulative = 0;
+      for (size_t i = 0; i < BUCKETS; ++i) {
+        cumulative += counts[i];
+        if (cumulative >= target) {
+          return std::min(bucketUpperBound(i), max);
+        }
+      }
+      return max;
+    }
+  };
+
+  LatencyHistogram()
+  {
+    for (auto& count : counts_) {
+      count.store(0, std::memory_order_relaxed);
+    }
+    max_.store(0, std::memory_order_relaxed);
+    previous_counts_.fill(0);
+  }
+
+  void record(std::chrono::nanoseconds duration)
+  {
+    const uint64_t value = duration.count() > 0 ? static_cast<uint64_t>(duration.count()) : 0;
+    // the control thread is the only writer, so plain load and store suffice for incrementing
+    std::atomic<uint64_t>& count = counts_[bucketIndex(value)];
+    count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    // snapshot() resets the maximum concurrently, so a plain store could overwrite the reset or be lost
+    uint64_t max = max_.load(std::memory_order_relaxed);
+    while (value > max && !max_.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+    }
+  }
+
+  /*!
+   * \brief Collects the values recorded since the last call and starts a new interval.
+   */
+  Snapshot snapshot()
+  {
+    Snapshot snapshot;
+    snapshot.count = 0;
+    for (size_t i = 0; i < BUCKETS; ++i) {
+      // the counters only grow, the interval is the difference to the previous snapshot
+      const uint64_t total = counts_[i].load(std::memory_order_relaxed);
+      snapshot.counts[i] = total - previous_counts_[i];
+      snapshot.count += snapshot.counts[i];
+      previous_counts_[i] = total;
+    }
+    snapshot.max = max_.exchange(0, std::memory_order_relaxed);
+
+    // A value recorded while the snapshot is taken may be counted in this interval, but end up with
+    // its maximum in the next one. The counts bound the maximum from below, so it is never reported
+    // smaller than a counted value's bucket.
+    for (size_t i = BUCKETS; i > 0; --i) {
+      if (snapshot.counts[i - 1] > 0) {
+        snapshot.max = std::max(snapshot.max, bucketLowerBound(i - 1));
+        break;
+      }
+    }
+    return snapshot;
+  }
+
+  static size_t bucketIndex(uint64_t value)
+  {
+    if (value < SUB_BUCKETS) {
+      return value;
+    }
+    const size_t exponent = 63 - __builtin_clzll(value);
+    if (exponent >= MAX_EXPONENT) {
+      return BUCKETS - 1;
+    }
+    const size_t shift = exponent - SUB_BUCKET_BITS;
+    return (shift + 1) * SUB_BUCKETS + static_cast<size_t>((value >> shift) - SUB_BUCKETS);
+  }
+
+  static uint64_t bucketLowerBound(size_t index)
+  {
+    if (index < SUB_BUCKETS) {
+      return index;
+    }
+    const size_t shift = index / SUB_BUCKETS - 1;
+    return static_cast<uint64_t>(SUB_BUCKETS + index % SUB_BUCKETS) << shift;
+  }
+
+  static uint64_t bucketUpperBound(size_t index)
+  {
+    if (index < SUB_BUCKETS) {
+      return index;
+    }
+    const size_t shift = index / SUB_BUCKETS - 1;
+    return bucketLowerBound(index) + (uint64_t(1) << shift) - 1;
+  }
+
+private:
+  std::array<std::atomic<uint64_t>, BUCKETS> counts_;
+  std::atomic<uint64_t> max_;
+
+  // owned by the thread calling snapshot()
+  std::array<uint64_t, BUCKETS> previous_counts_;
+};
+}  // namespace ur_robot_driver
+
+#endif  // UR_ROBOT_DRIVER__LATENCY_HISTOGRAM_HPP_
@@ -0,0 +1,194 @@
+// Copyright 2026 FZI Forschungszentrum Informatik
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef UR_ROBOT_DRIVER__RTDE_OUTPUT_BINDING_HPP_
+#define UR_ROBOT_DRIVER__RTDE_OUTPUT_BINDING_HPP_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ur_client_library/types.h"
+#include "ur_client_library/rtde/data_package.h"
+
+namespace ur_robot_driver
+{
+/*!
+ * \brief Storage types an RTDE output field can be decoded into. These mirror the alternatives of
+ * the client library's data package, so each binding maps onto exactly one getData instantiation.
+ */
+enum class RTDEFieldType
+{
+  BOOL,
+  UINT8,
+  UINT32,
+  UINT64,
+  INT32,
+  DOUBLE,
+  VECTOR3D,
+  VECTOR6D,
+  VECTOR6INT32,
+  VECTOR6UINT32
+};
+
+/*!
+ * \brief Table mapping the entries of an RTDE output recipe to typed destination members.
+ *
+ * The table is built once when the hardware is activated. Afterwards, decode() copies every bound
+ * field out of a data package in a single pass over the table. The field names are owned by the
+ * table, so decoding does not construct any strings and does not dispatch on field names.
+ */
+class RTDEOutputBinding
+{
+public:
+  /*!
+   * \brief Reads an RTDE recipe file, one field name per line. Empty lines are skipped.
+   *
+   * \param recipe_file Path to the recipe file
+   *
+   * \throws std::runtime_error if the file cannot be opened
+   *
+   * \returns The field names in the order they appear in the file
+   */
+  static std::vector<std::string> readRecipe(const std::string& recipe_file);
+
+  /*!
+   * \brief Looks up the type the robot uses to transmit an RTDE output field.
+   *
+   * \param name Name of the RTDE output field
+   * \param type Receives the field's type
+   *
+   * \returns False if the field is not a known RTDE output
+   */
+  static bool lookupFieldType(const std::string& name, RTDEFieldType& type);
+
+  void bind(const std::string& name, bool* destination);
+  void bind(const std::string& name, uint8_t* destination);
+  void bind(const std::string& name, uint32_t* destination);
+  void bind(const std::string& name, uint64_t* destination);
+  void bind(const std::string& name, int32_t* destination);
+  void bind(const std::string& name, double* destination);
+  void bind(const std::string& name, urcl::vector3d_t* destination);
+  void bind(const std::string& name, urcl::vector6d_t* destination);
+  void bind(const std::string& name, urcl::vector6int32_t* destination);
+  void bind(const std::string& name, urcl::vector6uint32_t* destination);
+
+  /*!
+   * \brief Removes all bindings.
+   */
+  void clear();
+
+  /*!
+   * \brief Checks whether a field has been bound.
+   *
+   * \param name Name of the RTDE field
+   *
+   * \returns True if the field is part of the table
+   */
+  bool contains(const std::string& name) const;
+
+  /*!
+   * \brief Number of bound fields.
+   */
+  size_t size() const
+  {
+    return bindings_.size();
+  }
+
+  /*!
+   * \brief Copies all bound fields from a data package into their destinations.
+   *
+   * \param data_pkg Package received from the robot
+   *
+   * \throws std::runtime_error if a bound field is missing in the package. This should never happen
+   * unless the table was built from a different recipe than the one used for the RTDE connection.
+   */
+  void decode(urcl::rtde_interface::DataPackage& data_pkg) const;
+
+private:
+  struct Binding
+  {
+    std::string name;
+    RTDEFieldType type;
+    void* destination;
+  };
+
+  void add(const std::string& name, RTDEFieldType type, void* destination);
+
+  std::vector<Binding> bindings_;
+};
+
+/*!
+ * \brief Decoding target for RTDE output fields that have no dedicated member in the hardware
+ * interface. The field's values are provided as doubles, so they can be exported as state
+ * interfaces.
+ */
+class GenericRTDEField
+{
+public:
+  GenericRTDEField(const std::string& name, RTDEFieldType type);
+
+  /*!
+   * \brief Adds the field to a binding table. Floating point fields are decoded directly into the
+   * exported values, all other types into an intermediate buffer.
+   *
+   * \param binding Table to add the field to
+   */
+  void bindTo(RTDEOutputBinding& binding);
+
+  /*!
+   * \brief Converts the decoded field into the exported values. Has to be called after each decode.
+   */
+  void update();
+
+  const std::string& getName() const
+  {
+    return name_;
+  }
+
+  /*!
+   * \brief Number of values the field consists of, e.g. 6 for a joint vector.
+   */
+  size_t size() const;
+
+  double* value(size_t index)
+  {
+    return &values_[index];
+  }
+
+private:
+  std::string name_;
+  RTDEFieldType type_;
+
+  bool bool_value_;
+  uint8_t uint8_value_;
+  uint32_t uint32_value_;
+  uint64_t uint64_value_;
+  int32_t int32_value_;
+  urcl::vector3d_t vector3d_value_;
+  urcl::vector6int32_t vector6int32_value_;
+  urcl::vector6uint32_t vector6uint32_value_;
+
+  urcl::vector6d_t values_;
+};
+}  // namespace ur_robot_driver
+
+#endif  // UR_ROBOT_DRIVER__RTDE_OUTPUT_BINDING_HPP_
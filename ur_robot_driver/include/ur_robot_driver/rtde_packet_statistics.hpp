@@ -0,0 +1,126 @@
+// Copyright 2026 FZI Forschungszentrum Informatik
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef UR_ROBOT_DRIVER__RTDE_PACKET_STATISTICS_HPP_
+#define UR_ROBOT_DRIVER__RTDE_PACKET_STATISTICS_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace ur_robot_driver
+{
+/*!
+ * \brief Detects lost, late and duplicate RTDE packets from consecutive robot timestamps.
+ *
+ * The robot stamps every RTDE package with its controller time, which advances by exactly one
+ * control step between two packages. The step is learned as the smallest positive difference seen
+ * between two timestamps. A larger difference means packages were lost on the way. A package that
+ * is stamped one step after its predecessor but reaches the control loop considerably later than
+ * one step after it counts as late.
+ *
+ * update() must only be called from a single thread, usually the control thread. The counters can
+ * be read from any thread without locking.
+ */
+class RTDEPacketStatistics
+{
+public:
+  RTDEPacketStatistics();
+
+  /*!
+   * \brief Forgets the last package and resets all counters, e.g. after a reconnect.
+   */
+  void reset();
+
+  /*!
+   * \brief Accounts for a received package.
+   *
+   * \param robot_timestamp RTDE timestamp of the package in seconds
+   * \param receive_time Host time the package was handed to the control loop
+   */
+  void update(double robot_timestamp, std::chrono::steady_clock::time_point receive_time);
+
+  uint64_t getReceivedPackets() const
+  {
+    return received_packets_.load(std::memory_order_relaxed);
+  }
+
+  /*!
+   * \brief Number of packages the robot sent, but which never arrived.
+   */
+  uint64_t getMissedPackets() const
+  {
+    return missed_packets_.load(std::memory_order_relaxed);
+  }
+
+  /*!
+   * \brief Number of packages that arrived more than 1.5 control steps after their predecessor.
+   */
+  uint64_t getLatePackets() const
+  {
+    return late_packets_.load(std::memory_order_relaxed);
+  }
+
+  /*!
+   * \brief Number of packages carrying the same timestamp as their predecessor.
+   */
+  uint64_t getDuplicatePackets() const
+  {
+    return duplicate_packets_.load(std::memory_order_relaxed);
+  }
+
+  /*!
+   * \brief Largest difference in seconds between the timestamps of two consecutive packages.
+   */
+  double getMaxGap() const
+  {
+    return max_gap_.load(std::memory_order_relaxed);
+  }
+
+  /*!
+   * \brief Control step of the robot in seconds as learned from the timestamps, zero if unknown.
+   */
+  double getControlStep() const
+  {
+    return control_step_.load(std::memory_order_relaxed);
+  }
+
+private:
+  // The control thread is the only writer, so plain load and store suffice for incrementing.
+  static void increment(std::atomic<uint64_t>& counter, uint64_t value = 1)
+  {
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+  }
+
+  bool has_last_package_;
+  double last_timestamp_;
+  std::chrono::steady_clock::time_point last_receive_time_;
+
+  std::atomic<uint64_t> received_packets_;
+  std::atomic<uint64_t> missed_packets_;
+  std::atomic<uint64_t> late_packets_;
+  std::atomic<uint64_t> duplicate_packets_;
+  std::atomic<double> max_gap_;
+  std::atomic<double> control_step_;
+};
+}  // namespace ur_robot_driver
+
+#endif  // UR_ROBOT_DRIVER__RTDE_PACKET_STATISTICS_HPP_
@@ -0,0 +1,109 @@
+// Copyright 2026 FZI Forschungszentrum Informatik
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef UR_ROBOT_DRIVER__SPSC_QUEUE_HPP_
+#define UR_ROBOT_DRIVER__SPSC_QUEUE_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace ur_robot_driver
+{
+/*!
+ * \brief Bounded lock-free queue for exactly one producer thread and one consumer thread.
+ *
+ * All storage is allocated with the queue, so pushing and popping never allocates. One slot is kept
+ * free to distinguish a full from an empty queue, i.e. the queue holds at most Capacity - 1 elements.
+ *
+ * \tparam T Element type, has to be default constructible and move assignable
+ * \tparam Capacity Number of slots
+ */
+template <typename T, size_t Capacity>
+class SPSCQueue
+{
+  static_assert(Capacity >= 2, "SPSCQueue needs at least two slots");
+
+public:
+  SPSCQueue() : head_(0), tail_(0)
+  {
+  }
+
+  /*!
+   * \brief Moves an element into the queue. Must only be called from the producer thread.
+   *
+   * \param item Element to insert. It is left untouched if the queue is full.
+   *
+   * \returns False if the queue is full
+   */
+  bool push(T&& item)
+  {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    const size_t next = increment(tail);
+    if (next == head_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    slots_[tail] = std::move(item);
+    tail_.store(next, std::memory_order_release);
+    return true;
+  }
+
+  /*!
+   * \brief Moves the oldest element out of the queue. Must only be called from the consumer thread.
+   *
+   * \param item Receives the element
+   *
+   * \returns False if the queue is empty
+   */
+  bool pop(T& item)
+  {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    item = std::move(slots_[head]);
+    head_.store(increment(head), std::memory_order_release);
+    return true;
+  }
+
+  /*!
+   * \brief Checks whether the queue is empty. The result is only a snapshot when called from the
+   * producer thread.
+   */
+  bool empty() const
+  {
+    return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+  }
+
+private:
+  static size_t increment(size_t index)
+  {
+    return (index + 1) % Capacity;
+  }
+
+  std::array<T, Capacity> slots_;
+  alignas(64) std::atomic<size_t> head_;
+  alignas(64) std::atomic<size_t> tail_;
+};
+}  // namespace ur_robot_driver
+
+#endif  // UR_ROBOT_DRIVER__SPSC_QUEUE_HPP_
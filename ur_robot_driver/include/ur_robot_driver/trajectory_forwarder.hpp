@@ -0,0 +1,153 @@
+// Copyright 2026 FZI Forschungszentrum Informatik
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef UR_ROBOT_DRIVER__TRAJECTORY_FORWARDER_HPP_
+#define UR_ROBOT_DRIVER__TRAJECTORY_FORWARDER_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+#include "ur_robot_driver/spsc_queue.hpp"
+
+namespace ur_robot_driver
+{
+/*!
+ * \brief Outcome of a forwarded trajectory as reported by the robot program.
+ */
+enum class TrajectoryResult : int32_t
+{
+  RUNNING = 0,
+  SUCCESS = 1,
+  CANCELED = 2,
+  FAILURE = 3
+};
+
+/*!
+ * \brief Waypoint of a forwarded trajectory. The robot moves from the previous waypoint to this one
+ * along a cubic spline within the given duration.
+ */
+struct TrajectoryPoint
+{
+  int32_t trajectory_id;
+  // index of the point, starting at 1
+  int32_t index;
+  // number of points of the trajectory
+  int32_t count;
+  std::array<double, 6> positions;
+  std::array<double, 6> velocities;
+  // time in seconds to get from the previous point to this one
+  double duration;
+};
+
+/*!
+ * \brief Progress report of the robot program, sent whenever it reached a waypoint or stopped.
+ */
+struct TrajectoryReport
+{
+  int32_t trajectory_id;
+  // number of points reached so far
+  int32_t points_done;
+  TrajectoryResult result;
+};
+
+/*!
+ * \brief Server of the trajectory socket the robot program connects to.
+ *
+ * The control thread queues waypoints, which a worker thread sends to the robot program as soon as
+ * they arrive. The robot program buffers them in the socket and executes them on its own, so the
+ * host is not involved in the interpolation. Reports of the robot program are handed back to the
+ * control thread. Both directions are bounded lock-free queues, so the control thread never blocks.
+ */
+class TrajectoryForwarder
+{
+public:
+  static constexpr size_t CAPACITY = 64;
+  // Fixed point factor of positions, velocities and durations on the socket
+  static constexpr double MULT = 1000000.0;
+
+  TrajectoryForwarder();
+  ~TrajectoryForwarder();
+
+  TrajectoryForwarder(const TrajectoryForwarder&) = delete;
+  TrajectoryForwarder& operator=(const TrajectoryForwarder&) = delete;
+
+  /*!
+   * \brief Opens the trajectory socket and starts the worker thread.
+   *
+   * \param port Port the robot program connects to
+   *
+   * \returns False if the port could not be opened
+   */
+  bool start(int port);
+
+  /*!
+   * \brief Closes all connections and stops the worker thread.
+   */
+  void stop();
+
+  /*!
+   * \brief Checks whether the robot program is connected to the trajectory socket.
+   */
+  bool isConnected() const
+  {
+    return connected_;
+  }
+
+  /*!
+   * \brief Queues a waypoint for the robot program. Called from the control thread.
+   *
+   * \returns False if the queue is full
+   */
+  bool postPoint(const TrajectoryPoint& point);
+
+  /*!
+   * \brief Takes the oldest report of the robot program. Called from the control thread.
+   *
+   * \returns False if there is no report
+   */
+  bool takeReport(TrajectoryReport& report);
+
+private:
+  void run();
+  void acceptClient();
+  bool sendPoints();
+  bool receiveReports();
+  void wake();
+  void closeClient();
+
+  SPSCQueue<TrajectoryPoint, CAPACITY> points_;
+  SPSCQueue<TrajectoryReport, CAPACITY> reports_;
+  int listen_fd_;
+  int client_fd_;
+  int event_fd_;
+  // bytes of an incomplete report
+  std::array<uint8_t, 12> report_buffer_;
+  size_t report_bytes_;
+  std::atomic<bool> connected_;
+  std::atomic<bool> shutdown_;
+  std::unique_ptr<std::thread> thread_;
+};
+}  // namespace ur_robot_driver
+
+#endif  // UR_ROBOT_DRIVER__TRAJECTORY_FORWARDER_HPP_
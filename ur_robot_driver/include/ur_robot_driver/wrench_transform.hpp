@@ -0,0 +1,58 @@
+// Copyright 2026 FZI Forschungszentrum Informatik
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef UR_ROBOT_DRIVER__WRENCH_TRANSFORM_HPP_
+#define UR_ROBOT_DRIVER__WRENCH_TRANSFORM_HPP_
+
+#include <Eigen/Geometry>
+
+#include "ur_client_library/types.h"
+
+namespace ur_robot_driver
+{
+/*!
+ * \brief Rotates the TCP wrench reported by the robot from the base frame into the tool frame.
+ *
+ * The robot reports the TCP orientation as rotation vector (axis times angle). The vector is turned
+ * into a rotation matrix directly, without a detour through quaternions or message types.
+ *
+ * \param tcp_pose TCP pose as reported in actual_TCP_pose, i.e. position followed by rotation vector
+ * \param wrench Force and torque as reported in actual_TCP_force. Receives the rotated wrench.
+ */
+inline void transformWrenchToTool(const urcl::vector6d_t& tcp_pose, urcl::vector6d_t& wrench)
+{
+  const Eigen::Vector3d rotation_vec(tcp_pose[3], tcp_pose[4], tcp_pose[5]);
+  const double angle = rotation_vec.norm();
+  if (angle <= 1e-16) {
+    // no rotation, the frames are aligned
+    return;
+  }
+
+  // the transposed rotation maps from base into tool coordinates
+  const Eigen::Matrix3d rotation_t = Eigen::AngleAxisd(angle, rotation_vec / angle).toRotationMatrix().transpose();
+  Eigen::Map<Eigen::Vector3d> force(wrench.data());
+  Eigen::Map<Eigen::Vector3d> torque(wrench.data() + 3);
+  force = rotation_t * force;
+  torque = rotation_t * torque;
+}
+}  // namespace ur_robot_driver
+
+#endif  // UR_ROBOT_DRIVER__WRENCH_TRANSFORM_HPP_
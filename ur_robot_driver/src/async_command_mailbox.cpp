@@ -0,0 +1,124 @@
+// Copyright 2026 FZI Forschungszentrum Informatik
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <thread>
+
+#include "ur_robot_driver/async_command_mailbox.hpp"
+
+namespace ur_robot_driver
+{
+AsyncCommandMailbox::AsyncCommandMailbox() : event_fd_(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+{
+}
+
+AsyncCommandMailbox::~AsyncCommandMailbox()
+{
+  if (event_fd_ >= 0) {
+    close(event_fd_);
+  }
+}
+
+bool AsyncCommandMailbox::postCommand(const AsyncCommand& command)
+{
+  AsyncCommand item = command;
+  if (!commands_.push(std::move(item))) {
+    return false;
+  }
+  wake();
+  return true;
+}
+
+bool AsyncCommandMailbox::postRegisters(const StreamedRegisters& registers)
+{
+  StreamedRegisters item = registers;
+  if (!registers_.push(std::move(item))) {
+    return false;
+  }
+  wake();
+  return true;
+}
+
+bool AsyncCommandMailbox::takeRegisters(StreamedRegisters& registers)
+{
+  return registers_.pop(registers);
+}
+
+bool AsyncCommandMailbox::postSentSequence(const SentSequence& sequence)
+{
+  SentSequence item = sequence;
+  return sent_sequences_.push(std::move(item));
+}
+
+bool AsyncCommandMailbox::takeSentSequence(SentSequence& sequence)
+{
+  return sent_sequences_.pop(sequence);
+}
+
+bool AsyncCommandMailbox::takeCommand(AsyncCommand& command)
+{
+  return commands_.pop(command);
+}
+
+bool AsyncCommandMailbox::postResult(const AsyncCommandResult& result)
+{
+  AsyncCommandResult item = result;
+  return results_.push(std::move(item));
+}
+
+bool AsyncCommandMailbox::takeResult(AsyncCommandResult& result)
+{
+  return results_.pop(result);
+}
+
+void AsyncCommandMailbox::wait(std::chrono::milliseconds timeout)
+{
+  // without an eventfd the worker falls back to polling
+  if (event_fd_ < 0) {
+    std::this_thread::sleep_for(timeout);
+    return;
+  }
+
+  pollfd event = { event_fd_, POLLIN, 0 };
+  if (poll(&event, 1, static_cast<int>(timeout.count())) > 0) {
+    // reset the counter, so the next wait blocks again
+    uint64_t count;
+    if (read(event_fd_, &count, sizeof(count)) < 0) {
+      return;
+    }
+  }
+}
+
+void AsyncCommandMailbox::wake()
+{
+  if (event_fd_ < 0) {
+    return;
+  }
+  const uint64_t one = 1;
+  // a full counter still wakes the worker, so a failed write can be ignored
+  if (write(event_fd_, &one, sizeof(one)) < 0) {
+    return;
+  }
+}
+}  // namespace ur_robot_driver
@@ -0,0 +1,57 @@
+// Copyright 2026 FZI Forschungszentrum Informatik
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include <memory>
+#include <utility>
+
+#include "ur_robot_driver/data_package_recycler.hpp"
+
+namespace rtde = urcl::rtde_interface;
+
+namespace ur_robot_driver
+{
+DataPackageRecycler::DataPackageRecycler() : control_thread_allocations_(0)
+{
+}
+
+void DataPackageRecycler::recycle(std::unique_ptr<rtde::DataPackage> data_pkg)
+{
+  if (!data_pkg) {
+    return;
+  }
+
+  if (!ring_.push(std::move(data_pkg))) {
+    control_thread_allocations_.fetch_add(1, std::memory_order_relaxed);
+    data_pkg.reset();
+  }
+}
+
+size_t DataPackageRecycler::drain()
+{
+  size_t released = 0;
+  std::unique_ptr<rtde::DataPackage> data_pkg;
+  while (ring_.pop(data_pkg)) {
+    data_pkg.reset();
+    ++released;
+  }
+  return released;
+}
+}  // namespace ur_robot_driver
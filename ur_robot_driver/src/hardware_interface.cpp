@@ -23,7 +23,15 @@
  */
 //----------------------------------------------------------------------
 #include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <future>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
@@ -40,6 +48,174 @@ namespace rtde = urcl::rtde_interface;
 
 namespace ur_robot_driver
 {
+namespace
+{
+// RTDE output fields read() relies on. The output recipe has to contain all of them, every other
+// field is optional.
+const std::vector<std::string> REQUIRED_OUTPUT_FIELDS = { "actual_q", "actual_qd", "actual_current", "speed_scaling",
+                                                          "runtime_state" };
+
+// Stores the current value as the last one and returns true if it differs from the last one or if
+// the value has to be converted anyway.
+template <typename T>
+bool valueChanged(const T& current, T& last, bool force)
+{
+  if (!force && current == last) {
+    return false;
+  }
+  last = current;
+  return true;
+}
+
+// Compares values that use NaN for "not set", which only equals itself here.
+bool sameValue(double a, double b)
+{
+  return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+template <size_t N>
+bool sameValues(const std::array<double, N>& a, const std::array<double, N>& b)
+{
+  for (size_t i = 0; i < N; ++i) {
+    if (!sameValue(a[i], b[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Waiting time between two attempts to reconnect to the robot. It is doubled after every failed
+// attempt up to the maximum.
+constexpr std::chrono::milliseconds RECONNECT_MIN_BACKOFF(100);
+constexpr std::chrono::milliseconds RECONNECT_MAX_BACKOFF(5000);
+
+// Placeholders in the URScript, which are replaced by the registers used for the latency probe, for
+// tracking the commands and for setting the payload and by the port of the trajectory socket
+const char LATENCY_PROBE_REGISTER_REPLACE[] = "{{LATENCY_PROBE_REGISTER_REPLACE}}";
+const char COMMAND_TRACKING_REGISTER_REPLACE[] = "{{COMMAND_TRACKING_REGISTER_REPLACE}}";
+const char PAYLOAD_REGISTER_REPLACE[] = "{{PAYLOAD_REGISTER_REPLACE}}";
+const char TRAJECTORY_PORT_REPLACE[] = "{{TRAJECTORY_PORT_REPLACE}}";
+// Placeholders for the servoj parameters and the register they are changed through at runtime
+const char SERVOJ_PARAMETER_REGISTER_REPLACE[] = "{{SERVOJ_PARAMETER_REGISTER_REPLACE}}";
+const char FORCE_MODE_REGISTER_REPLACE[] = "{{FORCE_MODE_REGISTER_REPLACE}}";
+const char SERVOJ_GAIN_REPLACE[] = "{{SERVOJ_GAIN_REPLACE}}";
+const char SERVOJ_LOOKAHEAD_TIME_REPLACE[] = "{{SERVOJ_LOOKAHEAD_TIME_REPLACE}}";
+// Placeholders for the extrapolation of late servo setpoints
+const char SERVO_EXTRAPOLATION_MODE_REPLACE[] = "{{SERVO_EXTRAPOLATION_MODE_REPLACE}}";
+const char SERVO_EXTRAPOLATION_MAX_STEPS_REPLACE[] = "{{SERVO_EXTRAPOLATION_MAX_STEPS_REPLACE}}";
+const char SERVO_EXTRAPOLATION_MAX_VELOCITY_REPLACE[] = "{{SERVO_EXTRAPOLATION_MAX_VELOCITY_REPLACE}}";
+const char SERVO_EXTRAPOLATION_MAX_ACCELERATION_REPLACE[] = "{{SERVO_EXTRAPOLATION_MAX_ACCELERATION_REPLACE}}";
+
+// Handshake of the "trajectory_forwarding/transfer_state" interface
+constexpr double TRANSFER_IDLE = 0.0;
+constexpr double TRANSFER_POINT_READY = 1.0;
+// The robot program receives the id of a trajectory to cancel as a joint value, which is scaled into
+// a 32 bit integer on the way. Ids wrap around well below the limit of that.
+constexpr int32_t MAX_TRAJECTORY_ID = 1000;
+
+// Ranges of the servoj parameters accepted by the robot
+constexpr double SERVOJ_GAIN_MIN = 100.0;
+constexpr double SERVOJ_GAIN_MAX = 2000.0;
+constexpr double SERVOJ_LOOKAHEAD_TIME_MIN = 0.03;
+constexpr double SERVOJ_LOOKAHEAD_TIME_MAX = 0.2;
+
+// The adaptive lookahead time is evaluated once per window. It grows by a step if more than the
+// given fraction of the cycles had jitter and shrinks by a step if there was none.
+const std::chrono::seconds SERVOJ_ADAPTATION_WINDOW(1);
+constexpr double SERVOJ_ADAPTATION_JITTER_FRACTION = 0.01;
+constexpr double SERVOJ_ADAPTATION_STEP = 0.005;
+// Without a position command for this long, the commands before are not compared with the robot
+// any more.
+const std::chrono::milliseconds SERVOJ_COMMAND_HISTORY_GAP(100);
+
+// Command interfaces of the TCP velocity, in the order speedl expects them
+const std::vector<std::string> TCP_TWIST_INTERFACES = { "linear_x",  "linear_y",  "linear_z",
+                                                        "angular_x", "angular_y", "angular_z" };
+
+// Axes of the force mode command interfaces
+const std::vector<std::string> FORCE_MODE_AXES = { "x", "y", "z", "rx", "ry", "rz" };
+
+// Force mode parameters a controller starts with: no compliant axis in a frame that is not transformed
+constexpr double FORCE_MODE_DEFAULT_TYPE = 2.0;
+const urcl::vector6d_t FORCE_MODE_DEFAULT_LIMITS = { { 0.1, 0.1, 0.1, 0.17, 0.17, 0.17 } };
+
+// The async thread sends a latency probe at most once per period. It only runs that often if it is
+// woken up, e.g. by command tracking, otherwise once per pass of its housekeeping.
+const std::chrono::milliseconds LATENCY_PROBE_PERIOD(10);
+
+// Input int and double registers an RTDE client may write. The lower ones are reserved for fieldbus
+// adapters.
+constexpr int FIRST_INPUT_REGISTER = 24;
+constexpr int LAST_INPUT_REGISTER = 47;
+
+// Time the robot program has to confirm a payload sent through the registers
+const std::chrono::milliseconds PAYLOAD_CONFIRMATION_TIMEOUT(500);
+
+// Replaces all occurrences of a placeholder in a script
+void replaceAll(std::string& script, const std::string& placeholder, const std::string& value)
+{
+  for (size_t pos = script.find(placeholder); pos != std::string::npos; pos = script.find(placeholder, pos)) {
+    script.replace(pos, placeholder.size(), value);
+  }
+}
+
+// Formats a number for the URScript, independent of the locale
+std::string toScriptValue(double value)
+{
+  std::ostringstream stream;
+  stream.imbue(std::locale::classic());
+  stream << value;
+  return stream.str();
+}
+
+// Duration in milliseconds, for the timing of the connection stages
+double toMilliseconds(std::chrono::steady_clock::duration duration)
+{
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+// Splits a list of RTDE fields separated by commas or whitespace
+std::vector<std::string> splitFieldList(const std::string& list)
+{
+  std::vector<std::string> fields;
+  std::string field;
+  std::istringstream stream(list);
+  while (stream >> field) {
+    std::istringstream items(field);
+    std::string item;
+    while (std::getline(items, item, ',')) {
+      if (!item.empty()) {
+        fields.push_back(item);
+      }
+    }
+  }
+  return fields;
+}
+
+// Returns true if field is a general purpose register whose name starts with prefix
+bool isRegister(const std::string& field, const std::string& prefix)
+{
+  RTDEFieldType type;
+  return field.compare(0, prefix.size(), prefix) == 0 && field.find("_register_") != std::string::npos &&
+         RTDEOutputBinding::lookupFieldType(field, type);
+}
+
+// Adds a field to a recipe unless it is part of it already
+void addToRecipe(std::vector<std::string>& recipe, const std::string& field)
+{
+  if (std::find(recipe.begin(), recipe.end(), field) == recipe.end()) {
+    recipe.push_back(field);
+  }
+}
+}  // namespace
+
+URPositionHardwareInterface::~URPositionHardwareInterface()
+{
+  if (!generated_files_directory_.empty()) {
+    std::error_code error;
+    std::filesystem::remove_all(generated_files_directory_, error);
+  }
+}
 
 CallbackReturn URPositionHardwareInterface::on_init(const hardware_interface::HardwareInfo& system_info)
 {
@@ -58,11 +234,28 @@ CallbackReturn URPositionHardwareInterface::on_init(const hardware_interface::Ha
   urcl_position_commands_ = { { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 } };
   urcl_position_commands_old_ = { { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 } };
   urcl_velocity_commands_ = { { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 } };
+  urcl_twist_commands_ = { { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 } };
+  robot_timestamp_ = 0.0;
+  actual_dig_out_bits_ = 0;
+  actual_dig_in_bits_ = 0;
+  analog_io_types_ = 0;
+  tool_analog_input_types_ = 0;
+  robot_status_bits_ = 0;
+  safety_status_bits_ = 0;
+  speed_scaling_ = 1.0;
+  target_speed_fraction_ = 1.0;
+  speed_scaling_combined_ = 1.0;
   stop_modes_ = { StoppingInterface::NONE, StoppingInterface::NONE, StoppingInterface::NONE,
                   StoppingInterface::NONE, StoppingInterface::NONE, StoppingInterface::NONE };
   start_modes_ = {};
   position_controller_running_ = false;
   velocity_controller_running_ = false;
+  start_twist_control_ = false;
+  stop_twist_control_ = false;
+  twist_controller_running_ = false;
+  start_trajectory_forwarding_ = false;
+  stop_trajectory_forwarding_ = false;
+  trajectory_forwarding_running_ = false;
   runtime_state_ = static_cast<uint32_t>(rtde::RUNTIME_STATE::STOPPED);
   pausing_state_ = PausingState::RUNNING;
   pausing_ramp_up_increment_ = 0.01;
@@ -71,10 +264,75 @@ CallbackReturn URPositionHardwareInterface::on_init(const hardware_interface::Ha
   initialized_ = false;
   async_thread_shutdown_ = false;
   system_interface_initialized_ = 0.0;
+  rtde_package_allocations_ = 0.0;
+  non_double_values_converted_ = false;
+  gpio_change_seq_ = 0.0;
+  reported_missed_packets_ = 0;
+  rtde_received_packets_ = 0.0;
+  rtde_missed_packets_ = 0.0;
+  rtde_late_packets_ = 0.0;
+  rtde_duplicate_packets_ = 0.0;
+  rtde_max_gap_ = 0.0;
+  stale_cycles_ = 0.0;
+  consecutive_stale_cycles_ = 0.0;
+  stale_cycles_since_write_ = 0;
+  robot_connected_ = 0.0;
+  reconnects_ = 0.0;
+  last_recovery_duration_ = 0.0;
+  connection_state_ = ConnectionState::DISCONNECTED;
+  standby_ = false;
+  latency_probe_echo_ = 0;
+  latency_probe_last_echo_ = 0;
+  latency_probe_seq_ = 0;
+  last_latency_probe_send_ = std::chrono::steady_clock::time_point();
+  latency_probe_write_cycles_ = 0;
+  latency_probe_samples_.fill({ 0, std::chrono::steady_clock::time_point(), 0 });
+  latency_probe_round_trip_cycles_ = 0.0;
+  latency_probe_round_trip_us_ = 0.0;
+  latency_probe_p50_us_ = 0.0;
+  latency_probe_p99_us_ = 0.0;
+  latency_probe_max_us_ = 0.0;
+  command_tracking_outputs_.fill(0);
+  command_seq_ = 0;
+  command_seq_sent_ = 0;
+  command_samples_.fill({ 0, std::chrono::steady_clock::time_point(), 0 });
+  command_age_cycles_ = 0.0;
+  command_age_us_ = 0.0;
+  robot_skipped_commands_ = 0.0;
+  robot_extrapolated_steps_ = 0.0;
+  robot_max_extrapolations_ = 0.0;
+  mode_switch_pending_ = false;
+  mode_switch_write_cycles_ = 0;
+  mode_switch_seq_ = 0;
+  mode_switch_cycles_ = 0.0;
+  mode_switch_us_ = 0.0;
+  mode_switch_robot_us_ = 0.0;
+  payload_echo_ = 0;
+  payload_seq_ = 0;
+  payload_pending_ = false;
+  payload_applied_latency_us_ = 0.0;
+  trajectory_setpoint_positions_ = { { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 } };
+  trajectory_setpoint_velocities_ = { { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 } };
+  trajectory_time_from_start_ = 0.0;
+  trajectory_number_of_points_ = 0.0;
+  trajectory_transfer_state_ = TRANSFER_IDLE;
+  trajectory_abort_ = 0.0;
+  trajectory_points_done_ = 0.0;
+  trajectory_result_ = static_cast<double>(TrajectoryResult::SUCCESS);
+  trajectory_id_ = 0;
+  trajectory_points_sent_ = 0;
+  trajectory_point_count_ = 0;
+  trajectory_last_time_from_start_ = 0.0;
+  trajectory_active_ = false;
+  trajectory_cancel_ = false;
+  position_command_step_ = { { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 } };
+  urcl_velocity_commands_old_ = { { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 } };
+  urcl_twist_commands_old_ = { { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 } };
 
   for (const hardware_interface::ComponentInfo& joint : info_.joints) {
     if (joint.name == "gpio" || joint.name == "speed_scaling" || joint.name == "resend_robot_program" ||
-        joint.name == "system_interface") {
+        joint.name == "system_interface" || joint.name == "trajectory_forwarding" || joint.name == "tcp_twist" ||
+        joint.name == "force_mode") {
       continue;
     }
     if (joint.command_interfaces.size() != 2) {
@@ -126,8 +384,419 @@ CallbackReturn URPositionHardwareInterface::on_init(const hardware_interface::Ha
     }
   }
 
+  // Optional recipe of slowly changing fields, e.g. tool temperature or IO states. These are streamed
+  // on a second RTDE connection at a low frequency, so the package decoded in every control cycle
+  // only contains what is needed for motion.
+  slow_output_recipe_filename_.clear();
+  slow_input_recipe_filename_.clear();
+  slow_output_frequency_ = 10.0;
+  if (info_.hardware_parameters.count("slow_output_recipe_filename")) {
+    slow_output_recipe_filename_ = info_.hardware_parameters["slow_output_recipe_filename"];
+    // The low-rate connection needs an input recipe of its own. It must not contain any input used by
+    // the main connection, as the robot only allows one client to write an input.
+    slow_input_recipe_filename_ = info_.hardware_parameters["slow_input_recipe_filename"];
+    if (info_.hardware_parameters.count("slow_output_frequency")) {
+      slow_output_frequency_ = stod(info_.hardware_parameters["slow_output_frequency"]);
+    }
+  }
+
+  // Integer register used to measure the round trip time through the robot. The hardware interface
+  // writes a sequence number into input_int_register_<n>, the robot program echoes it into
+  // output_int_register_<n>. Both have to be part of the RTDE recipes. -1 disables the probe.
+  latency_probe_register_ = -1;
+  if (info_.hardware_parameters.count("latency_probe_register")) {
+    latency_probe_register_ = stoi(info_.hardware_parameters["latency_probe_register"]);
+    if (latency_probe_register_ >= 0 &&
+        (latency_probe_register_ < FIRST_INPUT_REGISTER || latency_probe_register_ > LAST_INPUT_REGISTER)) {
+      RCLCPP_FATAL(rclcpp::get_logger("URPositionHardwareInterface"),
+                   "Invalid latency_probe_register %d, RTDE clients may write the integer registers 24 to 47.",
+                   latency_probe_register_);
+      return CallbackReturn::ERROR;
+    }
+  }
+  latency_probe_output_field_.clear();
+  if (latency_probe_register_ >= 0) {
+    latency_probe_output_field_ = "output_int_register_" + std::to_string(latency_probe_register_);
+  }
+
+  // First of the integer registers used to track how fresh the commands executed by the robot are.
+  // The hardware interface writes the sequence number of each command into input_int_register_<n>.
+  // The robot program reports the sequence number of the command it executes, the commands it
+  // skipped, the steps it extrapolated and the most consecutive extrapolations in
+  // output_int_register_<n> to output_int_register_<n+3>. -1 disables the tracking.
+  command_tracking_register_ = -1;
+  if (info_.hardware_parameters.count("command_tracking_register")) {
+    command_tracking_register_ = stoi(info_.hardware_parameters["command_tracking_register"]);
+    if (command_tracking_register_ >= 0 &&
+        (command_tracking_register_ < FIRST_INPUT_REGISTER || command_tracking_register_ > LAST_INPUT_REGISTER - 3)) {
+      RCLCPP_FATAL(rclcpp::get_logger("URPositionHardwareInterface"),
+                   "Invalid command_tracking_register %d, RTDE clients may write the integer registers 24 to 47 "
+                   "and four output registers are needed.",
+                   command_tracking_register_);
+      return CallbackReturn::ERROR;
+    }
+  }
+  command_tracking_output_fields_.clear();
+  if (command_tracking_register_ >= 0) {
+    for (int i = 0; i < 4; ++i) {
+      command_tracking_output_fields_.push_back("output_int_register_" +
+                                                std::to_string(command_tracking_register_ + i));
+    }
+  }
+
+  // First of the registers used to set the payload without a secondary script. The hardware interface
+  // writes mass and center of gravity into input_double_register_<n> to input_double_register_<n+3>
+  // and a sequence number into input_int_register_<n>. The robot program applies the payload and
+  // confirms it by echoing the sequence number into output_int_register_<n>. -1 disables this, the
+  // payload is then set with a secondary script, as it is while the robot program is not running.
+  payload_register_ = -1;
+  if (info_.hardware_parameters.count("payload_register")) {
+    payload_register_ = stoi(info_.hardware_parameters["payload_register"]);
+    if (payload_register_ >= 0 &&
+        (payload_register_ < FIRST_INPUT_REGISTER || payload_register_ > LAST_INPUT_REGISTER - 3)) {
+      RCLCPP_FATAL(rclcpp::get_logger("URPositionHardwareInterface"),
+                   "Invalid payload_register %d, RTDE clients may write the registers 24 to 47 and four double "
+                   "registers are needed.",
+                   payload_register_);
+      return CallbackReturn::ERROR;
+    }
+  }
+  payload_output_field_.clear();
+  if (payload_register_ >= 0) {
+    payload_output_field_ = "output_int_register_" + std::to_string(payload_register_);
+  }
+
+  // Port of the socket the robot program fetches forwarded trajectories from and reports their
+  // progress to. Without it, the "trajectory_forwarding" interfaces are not exported.
+  trajectory_port_ = -1;
+  if (info_.hardware_parameters.count("trajectory_port")) {
+    trajectory_port_ = stoi(info_.hardware_parameters["trajectory_port"]);
+    if (trajectory_port_ > 65535) {
+      RCLCPP_FATAL(rclcpp::get_logger("URPositionHardwareInterface"), "Invalid trajectory_port %d.",
+                   trajectory_port_);
+      return CallbackReturn::ERROR;
+    }
+    if (trajectory_port_ <= 0) {
+      trajectory_port_ = -1;
+    }
+  }
+
+  // Gain and lookahead time of servoj. They are baked into the robot program, but with a
+  // servoj_parameter_register they can be changed at runtime: The hardware interface then writes them
+  // into input_double_register_<n> and input_double_register_<n+1> and the robot program takes them
+  // over in the next servo cycle.
+  servoj_gain_ = stod(info_.hardware_parameters["servoj_gain"]);
+  servoj_lookahead_time_ = stod(info_.hardware_parameters["servoj_lookahead_time"]);
+  if (servoj_gain_ < SERVOJ_GAIN_MIN || servoj_gain_ > SERVOJ_GAIN_MAX ||
+      servoj_lookahead_time_ < SERVOJ_LOOKAHEAD_TIME_MIN || servoj_lookahead_time_ > SERVOJ_LOOKAHEAD_TIME_MAX) {
+    RCLCPP_FATAL(rclcpp::get_logger("URPositionHardwareInterface"),
+                 "Invalid servoj_gain %.0f or servoj_lookahead_time %.3f, the robot accepts gains from 100 to 2000 "
+                 "and lookahead times from 0.03 to 0.2 s.",
+                 servoj_gain_, servoj_lookahead_time_);
+    return CallbackReturn::ERROR;
+  }
+  servoj_parameter_register_ = -1;
+  if (info_.hardware_parameters.count("servoj_parameter_register")) {
+    servoj_parameter_register_ = stoi(info_.hardware_parameters["servoj_parameter_register"]);
+    if (servoj_parameter_register_ >= 0 && (servoj_parameter_register_ < FIRST_INPUT_REGISTER ||
+                                            servoj_parameter_register_ > LAST_INPUT_REGISTER - 1)) {
+      RCLCPP_FATAL(rclcpp::get_logger("URPositionHardwareInterface"),
+                   "Invalid servoj_parameter_register %d, RTDE clients may write the double registers 24 to 47 "
+                   "and two registers are needed.",
+                   servoj_parameter_register_);
+      return CallbackReturn::ERROR;
+    }
+  }
+  servoj_gain_cmd_ = NO_NEW_CMD_;
+  servoj_lookahead_time_cmd_ = NO_NEW_CMD_;
+  servoj_gain_sent_ = NO_NEW_CMD_;
+  servoj_lookahead_time_sent_ = NO_NEW_CMD_;
+
+  // With servoj_lookahead_adaptive the lookahead time follows the conditions of the position control
+  // between servoj_lookahead_min and servoj_lookahead_max. Jitter, i.e. stale cycles, late packages
+  // and setpoints the robot had to extrapolate, asks for a longer lookahead time to smooth the
+  // motion. Without jitter, or if the commands are tracked worse than
+  // servoj_tracking_error_tolerance in rad, it gets shorter again. servoj lags behind the commands by
+  // about the lookahead time, so the robot is compared with the command of one lookahead time ago.
+  // The setpoints the robot extrapolated are part of the jitter, so this needs command tracking.
+  servoj_lookahead_adaptive_ = false;
+  if (info_.hardware_parameters.count("servoj_lookahead_adaptive")) {
+    servoj_lookahead_adaptive_ = info_.hardware_parameters["servoj_lookahead_adaptive"] == "true" ||
+                                 info_.hardware_parameters["servoj_lookahead_adaptive"] == "True";
+  }
+  servoj_lookahead_min_ = SERVOJ_LOOKAHEAD_TIME_MIN;
+  if (info_.hardware_parameters.count("servoj_lookahead_min")) {
+    servoj_lookahead_min_ = stod(info_.hardware_parameters["servoj_lookahead_min"]);
+  }
+  servoj_lookahead_max_ = SERVOJ_LOOKAHEAD_TIME_MAX;
+  if (info_.hardware_parameters.count("servoj_lookahead_max")) {
+    servoj_lookahead_max_ = stod(info_.hardware_parameters["servoj_lookahead_max"]);
+  }
+  servoj_tracking_error_tolerance_ = 0.01;
+  if (info_.hardware_parameters.count("servoj_tracking_error_tolerance")) {
+    servoj_tracking_error_tolerance_ = stod(info_.hardware_parameters["servoj_tracking_error_tolerance"]);
+  }
+  if (servoj_lookahead_adaptive_) {
+    if (servoj_parameter_register_ < 0 || command_tracking_register_ < 0) {
+      RCLCPP_FATAL(rclcpp::get_logger("URPositionHardwareInterface"),
+                   "servoj_lookahead_adaptive needs a servoj_parameter_register and a command_tracking_register.");
+      return CallbackReturn::ERROR;
+    }
+    if (servoj_lookahead_min_ < SERVOJ_LOOKAHEAD_TIME_MIN || servoj_lookahead_max_ > SERVOJ_LOOKAHEAD_TIME_MAX ||
+        servoj_lookahead_min_ > servoj_lookahead_max_) {
+      RCLCPP_FATAL(rclcpp::get_logger("URPositionHardwareInterface"),
+                   "Invalid servoj_lookahead_min %.3f or servoj_lookahead_max %.3f, both have to be between 0.03 "
+                   "and 0.2 s.",
+                   servoj_lookahead_min_, servoj_lookahead_max_);
+      return CallbackReturn::ERROR;
+    }
+  }
+  servoj_adaptation_cycles_ = 0;
+  servoj_adaptation_jitter_baseline_ = 0.0;
+  servoj_adaptation_max_tracking_error_ = 0.0;
+  servoj_command_history_count_ = 0;
+  servoj_command_history_next_ = 0;
+
+  // Extrapolation of the robot program for servo setpoints that arrive late. "hold" keeps the last
+  // setpoint, "linear" continues with its last step and "quadratic" also with the change of the step.
+  // Steps are limited by the maximum joint velocity in rad/s and their change by the maximum joint
+  // acceleration in rad/s^2. After servo_extrapolation_max_steps consecutive extrapolations the robot
+  // program brakes with the maximum acceleration until the next setpoint arrives. 0 never brakes.
+  // This differs from stale_command_mode, which covers cycles in which the driver itself has no new
+  // robot state.
+  servo_extrapolation_mode_ = ServoExtrapolationMode::LINEAR;
+  if (info_.hardware_parameters.count("servo_extrapolation_mode")) {
+    const std::string mode = info_.hardware_parameters["servo_extrapolation_mode"];
+    if (mode == "hold") {
+      servo_extrapolation_mode_ = ServoExtrapolationMode::HOLD;
+    } else if (mode == "linear") {
+      servo_extrapolation_mode_ = ServoExtrapolationMode::LINEAR;
+    } else if (mode == "quadratic") {
+      servo_extrapolation_mode_ = ServoExtrapolationMode::QUADRATIC;
+    } else {
+      RCLCPP_FATAL(rclcpp::get_logger("URPositionHardwareInterface"),
+                   "Invalid servo_extrapolation_mode '%s', expected 'hold', 'linear' or 'quadratic'.", mode.c_str());
+      return CallbackReturn::ERROR;
+    }
+  }
+  servo_extrapolation_max_steps_ = 0;
+  if (info_.hardware_parameters.count("servo_extrapolation_max_steps")) {
+    servo_extrapolation_max_steps_ = stoi(info_.hardware_parameters["servo_extrapolation_max_steps"]);
+  }
+  servo_extrapolation_max_velocity_ = 3.15;
+  if (info_.hardware_parameters.count("servo_extrapolation_max_velocity")) {
+    servo_extrapolation_max_velocity_ = stod(info_.hardware_parameters["servo_extrapolation_max_velocity"]);
+  }
+  servo_extrapolation_max_acceleration_ = 10.0;
+  if (info_.hardware_parameters.count("servo_extrapolation_max_acceleration")) {
+    servo_extrapolation_max_acceleration_ = stod(info_.hardware_parameters["servo_extrapolation_max_acceleration"]);
+  }
+  if (servo_extrapolation_max_steps_ < 0 || servo_extrapolation_max_velocity_ <= 0.0 ||
+      servo_extrapolation_max_acceleration_ <= 0.0) {
+    RCLCPP_FATAL(rclcpp::get_logger("URPositionHardwareInterface"),
+                 "Invalid servo extrapolation limits, the maximum steps must not be negative and the maximum "
+                 "velocity and acceleration have to be positive.");
+    return CallbackReturn::ERROR;
+  }
+
+  // First of the registers force mode is streamed through. The hardware interface writes task frame,
+  // wrench and limits into input_double_register_<n> to input_double_register_<n+17>, the selection
+  // vector as bit mask into input_int_register_<n+1> and the force mode type into
+  // input_int_register_<n>. While a controller claims the "force_mode" interfaces, the robot program
+  // applies them in every control step, otherwise the type is 0 and force mode is off. -1 disables
+  // this and the interfaces are not exported.
+  force_mode_register_ = -1;
+  if (info_.hardware_parameters.count("force_mode_register")) {
+    force_mode_register_ = stoi(info_.hardware_parameters["force_mode_register"]);
+    if (force_mode_register_ >= 0 &&
+        (force_mode_register_ < FIRST_INPUT_REGISTER || force_mode_register_ > LAST_INPUT_REGISTER - 17)) {
+      RCLCPP_FATAL(rclcpp::get_logger("URPositionHardwareInterface"),
+                   "Invalid force_mode_register %d, RTDE clients may write the registers 24 to 47 and 18 double "
+                   "registers are needed.",
+                   force_mode_register_);
+      return CallbackReturn::ERROR;
+    }
+  }
+  force_mode_task_frame_ = { { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 } };
+  force_mode_selection_ = { { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 } };
+  force_mode_wrench_ = { { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 } };
+  force_mode_limits_ = FORCE_MODE_DEFAULT_LIMITS;
+  force_mode_type_ = FORCE_MODE_DEFAULT_TYPE;
+  force_mode_values_sent_.fill(NO_NEW_CMD_);
+  force_mode_selection_sent_ = -1;
+  force_mode_type_sent_ = -1;
+  streamed_registers_ = { false, {}, 0, 0, 0, {}, NO_NEW_CMD_, NO_NEW_CMD_ };
+  streamed_registers_.force_mode_values.fill(NO_NEW_CMD_);
+  streamed_registers_.register_values.fill(NO_NEW_CMD_);
+  streamed_registers_posted_ = streamed_registers_;
+  streamed_registers_received_ = streamed_registers_;
+  streamed_registers_available_ = false;
+  start_force_mode_ = false;
+  stop_force_mode_ = false;
+  force_mode_running_ = false;
+
+  // Connects to the robot on configuration instead of activation and keeps the connection while the
+  // hardware interface is inactive. Deactivation then only stops commanding the robot, the robot
+  // program keeps running idle, and activation resumes within a cycle.
+  warm_standby_ = false;
+  if (info_.hardware_parameters.count("warm_standby")) {
+    warm_standby_ =
+        info_.hardware_parameters["warm_standby"] == "true" || info_.hardware_parameters["warm_standby"] == "True";
+  }
+
+  // Registers the hardware interface uses itself. They are added to the RTDE recipes and cannot be
+  // exported as general purpose registers.
+  std::vector<std::string> reserved_input_registers;
+  std::vector<std::string> reserved_output_registers = command_tracking_output_fields_;
+  if (latency_probe_register_ >= 0) {
+    reserved_input_registers.push_back("input_int_register_" + std::to_string(latency_probe_register_));
+    reserved_output_registers.push_back(latency_probe_output_field_);
+  }
+  if (command_tracking_register_ >= 0) {
+    reserved_input_registers.push_back("input_int_register_" + std::to_string(command_tracking_register_));
+  }
+  if (payload_register_ >= 0) {
+    reserved_input_registers.push_back("input_int_register_" + std::to_string(payload_register_));
+    for (int i = 0; i < 4; ++i) {
+      reserved_input_registers.push_back("input_double_register_" + std::to_string(payload_register_ + i));
+    }
+    reserved_output_registers.push_back(payload_output_field_);
+  }
+  if (servoj_parameter_register_ >= 0) {
+    for (int i = 0; i < 2; ++i) {
+      reserved_input_registers.push_back("input_double_register_" + std::to_string(servoj_parameter_register_ + i));
+    }
+  }
+  if (force_mode_register_ >= 0) {
+    for (int i = 0; i < 2; ++i) {
+      reserved_input_registers.push_back("input_int_register_" + std::to_string(force_mode_register_ + i));
+    }
+    for (int i = 0; i < 18; ++i) {
+      reserved_input_registers.push_back("input_double_register_" + std::to_string(force_mode_register_ + i));
+    }
+  }
+  for (const std::vector<std::string>* reserved : { &reserved_input_registers, &reserved_output_registers }) {
+    for (auto it = reserved->begin(); it != reserved->end(); ++it) {
+      if (std::find(it + 1, reserved->end(), *it) != reserved->end()) {
+        RCLCPP_FATAL(rclcpp::get_logger("URPositionHardwareInterface"),
+                     "RTDE register '%s' is used by more than one of latency_probe_register, "
+                     "command_tracking_register, payload_register, servoj_parameter_register and "
+                     "force_mode_register.",
+                     it->c_str());
+        return CallbackReturn::ERROR;
+      }
+    }
+  }
+
+  // General purpose registers exchanged with the robot program at RTDE rate, e.g. for cell signals.
+  // rtde_input_registers lists input_{bit,int,double}_register_<n> the controllers can write through
+  // "rtde" command interfaces. rtde_output_registers lists registers exported as "rtde" state
+  // interfaces. Both are added to the RTDE recipes, so the recipe files do not have to contain them.
+  std::vector<std::string> input_registers;
+  if (info_.hardware_parameters.count("rtde_input_registers")) {
+    input_registers = splitFieldList(info_.hardware_parameters["rtde_input_registers"]);
+  }
+  std::vector<std::string> output_registers;
+  if (info_.hardware_parameters.count("rtde_output_registers")) {
+    output_registers = splitFieldList(info_.hardware_parameters["rtde_output_registers"]);
+  }
+  register_commands_.clear();
+  for (const std::string& field : input_registers) {
+    RTDEFieldType type;
+    if (!isRegister(field, "input_") || !RTDEOutputBinding::lookupFieldType(field, type)) {
+      RCLCPP_FATAL(rclcpp::get_logger("URPositionHardwareInterface"),
+                   "Invalid RTDE input register '%s'. Expected input_bit_register_<64-127>, "
+                   "input_int_register_<24-47> or input_double_register_<24-47>.",
+                   field.c_str());
+      return CallbackReturn::ERROR;
+    }
+    if (std::find(reserved_input_registers.begin(), reserved_input_registers.end(), field) !=
+        reserved_input_registers.end()) {
+      RCLCPP_FATAL(rclcpp::get_logger("URPositionHardwareInterface"),
+                   "RTDE input register '%s' is already used by the latency probe, the command tracking, "
+                   "the payload, the servoj parameters or force mode.",
+                   field.c_str());
+      return CallbackReturn::ERROR;
+    }
+    if (std::any_of(register_commands_.begin(), register_commands_.end(),
+                    [&field](const RegisterCommand& register_command) { return register_command.name == field; })) {
+      RCLCPP_FATAL(rclcpp::get_logger("URPositionHardwareInterface"), "RTDE input register '%s' is listed twice.",
+                   field.c_str());
+      return CallbackReturn::ERROR;
+    }
+    register_commands_.push_back(
+        { field, type, static_cast<uint32_t>(std::stoul(field.substr(field.rfind('_') + 1))), NO_NEW_CMD_ });
+  }
+  register_values_sent_.fill(NO_NEW_CMD_);
+  for (const std::string& field : output_registers) {
+    if (!isRegister(field, "")) {
+      RCLCPP_FATAL(rclcpp::get_logger("URPositionHardwareInterface"), "Invalid RTDE output register '%s'.",
+                   field.c_str());
+      return CallbackReturn::ERROR;
+    }
+    if (std::find(reserved_output_registers.begin(), reserved_output_registers.end(), field) !=
+        reserved_output_registers.end()) {
+      RCLCPP_FATAL(rclcpp::get_logger("URPositionHardwareInterface"),
+                   "RTDE output register '%s' is already used by the latency probe, the command tracking or "
+                   "the payload.",
+                   field.c_str());
+      return CallbackReturn::ERROR;
+    }
+  }
+
+  // The state interfaces depend on the output recipe, so it has to be known before they are exported.
+  try {
+    std::vector<std::string> slow_output_recipe;
+    if (!slow_output_recipe_filename_.empty()) {
+      slow_output_recipe = RTDEOutputBinding::readRecipe(slow_output_recipe_filename_);
+    }
+
+    output_recipe_ = RTDEOutputBinding::readRecipe(info_.hardware_parameters["output_recipe_filename"]);
+    for (const std::string& field : reserved_output_registers) {
+      addToRecipe(output_recipe_, field);
+    }
+    for (const std::string& field : output_registers) {
+      addToRecipe(output_recipe_, field);
+    }
+    if (!bindOutputRecipe(output_recipe_, slow_output_recipe)) {
+      return CallbackReturn::ERROR;
+    }
+
+    input_recipe_ = RTDEOutputBinding::readRecipe(info_.hardware_parameters["input_recipe_filename"]);
+    for (const std::string& field : reserved_input_registers) {
+      addToRecipe(input_recipe_, field);
+    }
+    for (const std::string& field : input_registers) {
+      addToRecipe(input_recipe_, field);
+    }
+
+    // the robot only allows one client to write an input
+    if (!slow_input_recipe_filename_.empty()) {
+      for (const std::string& field : RTDEOutputBinding::readRecipe(slow_input_recipe_filename_)) {
+        if (std::find(input_recipe_.begin(), input_recipe_.end(), field) != input_recipe_.end()) {
+          RCLCPP_FATAL(rclcpp::get_logger("URPositionHardwareInterface"),
+                       "RTDE input '%s' is part of both the input recipe and the slow input recipe.", field.c_str());
+          return CallbackReturn::ERROR;
+        }
+      }
+    }
+  } catch (const std::runtime_error& e) {
+    RCLCPP_FATAL_STREAM(rclcpp::get_logger("URPositionHardwareInterface"), e.what());
+    return CallbackReturn::ERROR;
+  }
+
+  // Without a force torque sensor in the description nobody can claim the wrench, so there is no
+  // need to transform it. The sensor provides the wrench in tool coordinates, which needs the TCP pose.
+  if (tcp_force_in_recipe_ && !tcp_pose_in_recipe_ && !info_.sensors.empty()) {
+    RCLCPP_FATAL(rclcpp::get_logger("URPositionHardwareInterface"),
+                 "RTDE output recipe contains 'actual_TCP_force' but not 'actual_TCP_pose', which is needed to "
+                 "transform the wrench of sensor '%s' into tool coordinates.",
+                 info_.sensors[0].name.c_str());
+    return CallbackReturn::ERROR;
+  }
+  transform_wrench_ = tcp_force_in_recipe_ && !info_.sensors.empty();
+
   return CallbackReturn::SUCCESS;
-  ;
 }
 
 std::vector<hardware_interface::StateInterface> URPositionHardwareInterface::export_state_interfaces()
@@ -135,7 +804,9 @@ std::vector<hardware_interface::StateInterface> URPositionHardwareInterface::exp
   std::vector<hardware_interface::StateInterface> state_interfaces;
   for (size_t i = 0; i < info_.joints.size(); ++i) {
     if (info_.joints[i].name == "gpio" || info_.joints[i].name == "speed_scaling" ||
-        info_.joints[i].name == "resend_robot_program" || info_.joints[i].name == "system_interface") {
+        info_.joints[i].name == "resend_robot_program" || info_.joints[i].name == "system_interface" ||
+        info_.joints[i].name == "trajectory_forwarding" || info_.joints[i].name == "tcp_twist" ||
+        info_.joints[i].name == "force_mode") {
       continue;
     }
     state_interfaces.emplace_back(hardware_interface::StateInterface(
@@ -151,62 +822,194 @@ std::vector<hardware_interface::StateInterface> URPositionHardwareInterface::exp
   state_interfaces.emplace_back(
       hardware_interface::StateInterface("speed_scaling", "speed_scaling_factor", &speed_scaling_combined_));
 
-  for (auto& sensor : info_.sensors) {
-    for (uint j = 0; j < sensor.state_interfaces.size(); ++j) {
-      state_interfaces.emplace_back(hardware_interface::StateInterface(sensor.name, sensor.state_interfaces[j].name,
-                                                                       &urcl_ft_sensor_measurements_[j]));
+  // Everything below is only exported if the output recipe contains the corresponding field
+  if (tcp_force_in_recipe_) {
+    for (auto& sensor : info_.sensors) {
+      for (uint j = 0; j < sensor.state_interfaces.size(); ++j) {
+        state_interfaces.emplace_back(hardware_interface::StateInterface(sensor.name, sensor.state_interfaces[j].name,
+                                                                         &urcl_ft_sensor_measurements_[j]));
+      }
     }
   }
 
   for (size_t i = 0; i < 18; ++i) {
-    state_interfaces.emplace_back(hardware_interface::StateInterface("gpio", "digital_output_" + std::to_string(i),
-                                                                     &actual_dig_out_bits_copy_[i]));
-    state_interfaces.emplace_back(
-        hardware_interface::StateInterface("gpio", "digital_input_" + std::to_string(i), &actual_dig_in_bits_copy_[i]));
+    if (isOutputFieldStreamed("actual_digital_output_bits")) {
+      state_interfaces.emplace_back(hardware_interface::StateInterface("gpio", "digital_output_" + std::to_string(i),
+                                                                       &actual_dig_out_bits_copy_[i]));
+    }
+    if (isOutputFieldStreamed("actual_digital_input_bits")) {
+      state_interfaces.emplace_back(hardware_interface::StateInterface("gpio", "digital_input_" + std::to_string(i),
+                                                                       &actual_dig_in_bits_copy_[i]));
+    }
   }
 
-  for (size_t i = 0; i < 11; ++i) {
-    state_interfaces.emplace_back(hardware_interface::StateInterface("gpio", "safety_status_bit_" + std::to_string(i),
-                                                                     &safety_status_bits_copy_[i]));
+  if (isOutputFieldStreamed("safety_status_bits")) {
+    for (size_t i = 0; i < 11; ++i) {
+      state_interfaces.emplace_back(hardware_interface::StateInterface(
+          "gpio", "safety_status_bit_" + std::to_string(i), &safety_status_bits_copy_[i]));
+    }
   }
 
   for (size_t i = 0; i < 4; ++i) {
-    state_interfaces.emplace_back(
-        hardware_interface::StateInterface("gpio", "analog_io_type_" + std::to_string(i), &analog_io_types_copy_[i]));
-    state_interfaces.emplace_back(hardware_interface::StateInterface("gpio", "robot_status_bit_" + std::to_string(i),
-                                                                     &robot_status_bits_copy_[i]));
+    if (isOutputFieldStreamed("analog_io_types")) {
+      state_interfaces.emplace_back(hardware_interface::StateInterface("gpio", "analog_io_type_" + std::to_string(i),
+                                                                       &analog_io_types_copy_[i]));
+    }
+    if (isOutputFieldStreamed("robot_status_bits")) {
+      state_interfaces.emplace_back(hardware_interface::StateInterface(
+          "gpio", "robot_status_bit_" + std::to_string(i), &robot_status_bits_copy_[i]));
+    }
   }
 
   for (size_t i = 0; i < 2; ++i) {
-    state_interfaces.emplace_back(hardware_interface::StateInterface(
-        "gpio", "tool_analog_input_type_" + std::to_string(i), &tool_analog_input_types_copy_[i]));
+    if (isOutputFieldStreamed("tool_analog_input_types")) {
+      state_interfaces.emplace_back(hardware_interface::StateInterface(
+          "gpio", "tool_analog_input_type_" + std::to_string(i), &tool_analog_input_types_copy_[i]));
+    }
+
+    if (isOutputFieldStreamed("tool_analog_input" + std::to_string(i))) {
+      state_interfaces.emplace_back(hardware_interface::StateInterface(
+          "gpio", "tool_analog_input_" + std::to_string(i), &tool_analog_input_[i]));
+    }
+
+    if (isOutputFieldStreamed("standard_analog_input" + std::to_string(i))) {
+      state_interfaces.emplace_back(hardware_interface::StateInterface(
+          "gpio", "standard_analog_input_" + std::to_string(i), &standard_analog_input_[i]));
+    }
+
+    if (isOutputFieldStreamed("standard_analog_output" + std::to_string(i))) {
+      state_interfaces.emplace_back(hardware_interface::StateInterface(
+          "gpio", "standard_analog_output_" + std::to_string(i), &standard_analog_output_[i]));
+    }
+  }
 
+  if (isOutputFieldStreamed("tool_output_voltage")) {
     state_interfaces.emplace_back(
-        hardware_interface::StateInterface("gpio", "tool_analog_input_" + std::to_string(i), &tool_analog_input_[i]));
+        hardware_interface::StateInterface("gpio", "tool_output_voltage", &tool_output_voltage_copy_));
+  }
 
-    state_interfaces.emplace_back(hardware_interface::StateInterface(
-        "gpio", "standard_analog_input_" + std::to_string(i), &standard_analog_input_[i]));
+  if (isOutputFieldStreamed("robot_mode")) {
+    state_interfaces.emplace_back(hardware_interface::StateInterface("gpio", "robot_mode", &robot_mode_copy_));
+  }
 
-    state_interfaces.emplace_back(hardware_interface::StateInterface(
-        "gpio", "standard_analog_output_" + std::to_string(i), &standard_analog_output_[i]));
+  if (isOutputFieldStreamed("safety_mode")) {
+    state_interfaces.emplace_back(hardware_interface::StateInterface("gpio", "safety_mode", &safety_mode_copy_));
+  }
+
+  if (isOutputFieldStreamed("tool_mode")) {
+    state_interfaces.emplace_back(hardware_interface::StateInterface("gpio", "tool_mode", &tool_mode_copy_));
   }
 
+  if (isOutputFieldStreamed("tool_output_current")) {
+    state_interfaces.emplace_back(
+        hardware_interface::StateInterface("gpio", "tool_output_current", &tool_output_current_));
+  }
+
+  if (isOutputFieldStreamed("tool_temperature")) {
+    state_interfaces.emplace_back(hardware_interface::StateInterface("gpio", "tool_temperature", &tool_temperature_));
+  }
+
+  // fields without a dedicated interface are exported as they come from the robot
+  for (auto* generic_fields : { &generic_output_fields_, &generic_slow_output_fields_ }) {
+    for (auto& field : *generic_fields) {
+      if (field->size() == 1) {
+        state_interfaces.emplace_back(hardware_interface::StateInterface("rtde", field->getName(), field->value(0)));
+      } else {
+        for (size_t i = 0; i < field->size(); ++i) {
+          state_interfaces.emplace_back(hardware_interface::StateInterface(
+              "rtde", field->getName() + "_" + std::to_string(i), field->value(i)));
+        }
+      }
+    }
+  }
+
+  state_interfaces.emplace_back(hardware_interface::StateInterface("gpio", "change_seq", &gpio_change_seq_));
+
   state_interfaces.emplace_back(
-      hardware_interface::StateInterface("gpio", "tool_output_voltage", &tool_output_voltage_copy_));
+      hardware_interface::StateInterface("system_interface", "initialized", &system_interface_initialized_));
 
-  state_interfaces.emplace_back(hardware_interface::StateInterface("gpio", "robot_mode", &robot_mode_copy_));
+  if (timestamp_in_recipe_) {
+    state_interfaces.emplace_back(
+        hardware_interface::StateInterface("system_interface", "robot_timestamp", &robot_timestamp_));
+    state_interfaces.emplace_back(
+        hardware_interface::StateInterface("system_interface", "rtde_received_packets", &rtde_received_packets_));
+    state_interfaces.emplace_back(
+        hardware_interface::StateInterface("system_interface", "rtde_missed_packets", &rtde_missed_packets_));
+    state_interfaces.emplace_back(
+        hardware_interface::StateInterface("system_interface", "rtde_late_packets", &rtde_late_packets_));
+    state_interfaces.emplace_back(
+        hardware_interface::StateInterface("system_interface", "rtde_duplicate_packets", &rtde_duplicate_packets_));
+    state_interfaces.emplace_back(
+        hardware_interface::StateInterface("system_interface", "rtde_max_gap", &rtde_max_gap_));
+  }
 
-  state_interfaces.emplace_back(hardware_interface::StateInterface("gpio", "safety_mode", &safety_mode_copy_));
+  state_interfaces.emplace_back(
+      hardware_interface::StateInterface("system_interface", "stale_cycles", &stale_cycles_));
 
-  state_interfaces.emplace_back(hardware_interface::StateInterface("gpio", "tool_mode", &tool_mode_copy_));
+  state_interfaces.emplace_back(
+      hardware_interface::StateInterface("system_interface", "consecutive_stale_cycles", &consecutive_stale_cycles_));
 
   state_interfaces.emplace_back(
-      hardware_interface::StateInterface("gpio", "tool_output_current", &tool_output_current_));
+      hardware_interface::StateInterface("system_interface", "robot_connected", &robot_connected_));
 
-  state_interfaces.emplace_back(hardware_interface::StateInterface("gpio", "tool_temperature", &tool_temperature_));
+  state_interfaces.emplace_back(hardware_interface::StateInterface("system_interface", "reconnects", &reconnects_));
 
   state_interfaces.emplace_back(
-      hardware_interface::StateInterface("system_interface", "initialized", &system_interface_initialized_));
+      hardware_interface::StateInterface("system_interface", "last_recovery_duration", &last_recovery_duration_));
+  state_interfaces.emplace_back(
+      hardware_interface::StateInterface("system_interface", "mode_switch_cycles", &mode_switch_cycles_));
+  state_interfaces.emplace_back(
+      hardware_interface::StateInterface("system_interface", "mode_switch_us", &mode_switch_us_));
+
+  if (latency_probe_register_ >= 0) {
+    state_interfaces.emplace_back(hardware_interface::StateInterface(
+        "system_interface", "latency_probe_round_trip_cycles", &latency_probe_round_trip_cycles_));
+    state_interfaces.emplace_back(hardware_interface::StateInterface(
+        "system_interface", "latency_probe_round_trip_us", &latency_probe_round_trip_us_));
+    state_interfaces.emplace_back(
+        hardware_interface::StateInterface("system_interface", "latency_probe_p50_us", &latency_probe_p50_us_));
+    state_interfaces.emplace_back(
+        hardware_interface::StateInterface("system_interface", "latency_probe_p99_us", &latency_probe_p99_us_));
+    state_interfaces.emplace_back(
+        hardware_interface::StateInterface("system_interface", "latency_probe_max_us", &latency_probe_max_us_));
+  }
+
+  if (command_tracking_register_ >= 0) {
+    state_interfaces.emplace_back(
+        hardware_interface::StateInterface("system_interface", "command_age_cycles", &command_age_cycles_));
+    state_interfaces.emplace_back(
+        hardware_interface::StateInterface("system_interface", "command_age_us", &command_age_us_));
+    state_interfaces.emplace_back(
+        hardware_interface::StateInterface("system_interface", "robot_skipped_commands", &robot_skipped_commands_));
+    state_interfaces.emplace_back(hardware_interface::StateInterface("system_interface", "robot_extrapolated_steps",
+                                                                     &robot_extrapolated_steps_));
+    state_interfaces.emplace_back(hardware_interface::StateInterface("system_interface", "robot_max_extrapolations",
+                                                                     &robot_max_extrapolations_));
+    state_interfaces.emplace_back(
+        hardware_interface::StateInterface("system_interface", "mode_switch_robot_us", &mode_switch_robot_us_));
+  }
+
+  if (payload_register_ >= 0) {
+    state_interfaces.emplace_back(hardware_interface::StateInterface("system_interface", "payload_applied_latency_us",
+                                                                     &payload_applied_latency_us_));
+  }
+
+  if (servoj_parameter_register_ >= 0) {
+    state_interfaces.emplace_back(hardware_interface::StateInterface("servoj", "gain", &servoj_gain_));
+    state_interfaces.emplace_back(
+        hardware_interface::StateInterface("servoj", "lookahead_time", &servoj_lookahead_time_));
+  }
+
+  if (trajectory_port_ > 0) {
+    state_interfaces.emplace_back(
+        hardware_interface::StateInterface("trajectory_forwarding", "points_done", &trajectory_points_done_));
+    state_interfaces.emplace_back(
+        hardware_interface::StateInterface("trajectory_forwarding", "result", &trajectory_result_));
+  }
+
+  // heap operations on RTDE packages in the control thread, zero as long as the recycler keeps up
+  state_interfaces.emplace_back(hardware_interface::StateInterface("system_interface", "rtde_package_allocations",
+                                                                   &rtde_package_allocations_));
 
   return state_interfaces;
 }
@@ -216,7 +1019,9 @@ std::vector<hardware_interface::CommandInterface> URPositionHardwareInterface::e
   std::vector<hardware_interface::CommandInterface> command_interfaces;
   for (size_t i = 0; i < info_.joints.size(); ++i) {
     if (info_.joints[i].name == "gpio" || info_.joints[i].name == "speed_scaling" ||
-        info_.joints[i].name == "resend_robot_program" || info_.joints[i].name == "system_interface") {
+        info_.joints[i].name == "resend_robot_program" || info_.joints[i].name == "system_interface" ||
+        info_.joints[i].name == "trajectory_forwarding" || info_.joints[i].name == "tcp_twist" ||
+        info_.joints[i].name == "force_mode") {
       continue;
     }
     command_interfaces.emplace_back(hardware_interface::CommandInterface(
@@ -240,6 +1045,11 @@ std::vector<hardware_interface::CommandInterface> URPositionHardwareInterface::e
   command_interfaces.emplace_back(hardware_interface::CommandInterface(
       "resend_robot_program", "resend_robot_program_async_success", &resend_robot_program_async_success_));
 
+  for (size_t i = 0; i < 6; ++i) {
+    command_interfaces.emplace_back(
+        hardware_interface::CommandInterface("tcp_twist", TCP_TWIST_INTERFACES[i], &urcl_twist_commands_[i]));
+  }
+
   command_interfaces.emplace_back(hardware_interface::CommandInterface("payload", "mass", &payload_mass_));
   command_interfaces.emplace_back(
       hardware_interface::CommandInterface("payload", "cog.x", &payload_center_of_gravity_[0]));
@@ -260,22 +1070,179 @@ std::vector<hardware_interface::CommandInterface> URPositionHardwareInterface::e
         "gpio", "standard_analog_output_cmd_" + std::to_string(i), &standard_analog_output_cmd_[i]));
   }
 
+  for (RegisterCommand& register_command : register_commands_) {
+    command_interfaces.emplace_back(
+        hardware_interface::CommandInterface("rtde", register_command.name, &register_command.command));
+  }
+
+  if (servoj_parameter_register_ >= 0) {
+    command_interfaces.emplace_back(hardware_interface::CommandInterface("servoj", "gain_cmd", &servoj_gain_cmd_));
+    command_interfaces.emplace_back(
+        hardware_interface::CommandInterface("servoj", "lookahead_time_cmd", &servoj_lookahead_time_cmd_));
+  }
+
+  if (force_mode_register_ >= 0) {
+    for (size_t i = 0; i < 6; ++i) {
+      command_interfaces.emplace_back(hardware_interface::CommandInterface(
+          "force_mode", "task_frame_" + FORCE_MODE_AXES[i], &force_mode_task_frame_[i]));
+      command_interfaces.emplace_back(hardware_interface::CommandInterface(
+          "force_mode", "selection_" + FORCE_MODE_AXES[i], &force_mode_selection_[i]));
+      command_interfaces.emplace_back(
+          hardware_interface::CommandInterface("force_mode", "wrench_" + FORCE_MODE_AXES[i], &force_mode_wrench_[i]));
+      command_interfaces.emplace_back(
+          hardware_interface::CommandInterface("force_mode", "limit_" + FORCE_MODE_AXES[i], &force_mode_limits_[i]));
+    }
+    command_interfaces.emplace_back(hardware_interface::CommandInterface("force_mode", "type", &force_mode_type_));
+  }
+
+  if (trajectory_port_ > 0) {
+    for (size_t i = 0; i < 6; ++i) {
+      command_interfaces.emplace_back(hardware_interface::CommandInterface(
+          "trajectory_forwarding", "setpoint_position_" + std::to_string(i), &trajectory_setpoint_positions_[i]));
+      command_interfaces.emplace_back(hardware_interface::CommandInterface(
+          "trajectory_forwarding", "setpoint_velocity_" + std::to_string(i), &trajectory_setpoint_velocities_[i]));
+    }
+    command_interfaces.emplace_back(
+        hardware_interface::CommandInterface("trajectory_forwarding", "time_from_start", &trajectory_time_from_start_));
+    command_interfaces.emplace_back(hardware_interface::CommandInterface("trajectory_forwarding", "number_of_points",
+                                                                         &trajectory_number_of_points_));
+    command_interfaces.emplace_back(
+        hardware_interface::CommandInterface("trajectory_forwarding", "transfer_state", &trajectory_transfer_state_));
+    command_interfaces.emplace_back(
+        hardware_interface::CommandInterface("trajectory_forwarding", "abort", &trajectory_abort_));
+  }
+
   return command_interfaces;
 }
 
+CallbackReturn URPositionHardwareInterface::on_configure(const rclcpp_lifecycle::State& previous_state)
+{
+  if (!warm_standby_) {
+    return CallbackReturn::SUCCESS;
+  }
+
+  RCLCPP_INFO(rclcpp::get_logger("URPositionHardwareInterface"), "Connecting for warm standby ...please wait...");
+  const CallbackReturn result = startDriver();
+  if (result == CallbackReturn::SUCCESS) {
+    standby_ = true;
+  }
+  return result;
+}
+
+CallbackReturn URPositionHardwareInterface::on_cleanup(const rclcpp_lifecycle::State& previous_state)
+{
+  if (connection_state_ != ConnectionState::DISCONNECTED) {
+    stopDriver();
+  }
+  standby_ = false;
+  return CallbackReturn::SUCCESS;
+}
+
+CallbackReturn URPositionHardwareInterface::on_shutdown(const rclcpp_lifecycle::State& previous_state)
+{
+  return on_cleanup(previous_state);
+}
+
 CallbackReturn URPositionHardwareInterface::on_activate(const rclcpp_lifecycle::State& previous_state)
 {
   RCLCPP_INFO(rclcpp::get_logger("URPositionHardwareInterface"), "Starting ...please wait...");
+  const auto activation_start = std::chrono::steady_clock::now();
 
-  // The robot's IP address.
-  std::string robot_ip = info_.hardware_parameters["robot_ip"];
-  // Path to the urscript code that will be sent to the robot
-  std::string script_filename = info_.hardware_parameters["script_filename"];
-  // Path to the file containing the recipe used for requesting RTDE outputs.
-  std::string output_recipe_filename = info_.hardware_parameters["output_recipe_filename"];
-  // Path to the file containing the recipe used for requesting RTDE inputs.
-  std::string input_recipe_filename = info_.hardware_parameters["input_recipe_filename"];
-  // Start robot in headless mode. This does not require the 'External Control' URCap to be running
+  if (connection_state_ == ConnectionState::DISCONNECTED) {
+    const CallbackReturn result = startDriver();
+    if (result != CallbackReturn::SUCCESS) {
+      return result;
+    }
+  } else {
+    // Resuming from warm standby. The robot may have been moved in the meantime, so the commands
+    // continue from where it is now.
+    urcl_position_commands_ = urcl_position_commands_old_ = urcl_joint_positions_;
+    urcl_velocity_commands_ = { { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 } };
+    urcl_twist_commands_ = { { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 } };
+    resetStaleCommands();
+  }
+  standby_ = false;
+
+  RCLCPP_INFO(rclcpp::get_logger("URPositionHardwareInterface"), "System successfully started in %.1f ms!",
+              toMilliseconds(std::chrono::steady_clock::now() - activation_start));
+
+  return CallbackReturn::SUCCESS;
+}
+
+CallbackReturn URPositionHardwareInterface::startDriver()
+{
+  // Enables non_blocking_read mode. Should only be used with combined_robot_hw. Disables error generated when read
+  // returns without any data, sets the read timeout to zero, and synchronises read/write operations. Enabling this when
+  // not used with combined_robot_hw can suppress important errors and affect real-time performance.
+  non_blocking_read_ = static_cast<bool>(stoi(info_.hardware_parameters["non_blocking_read"]));
+
+  // Time in seconds read() waits for a package in non_blocking_read mode before it gives up and
+  // marks the state as stale. The default of zero does not wait at all.
+  read_budget_ = std::chrono::duration<double>(0.0);
+  if (info_.hardware_parameters.count("non_blocking_read_budget")) {
+    read_budget_ = std::chrono::duration<double>(stod(info_.hardware_parameters["non_blocking_read_budget"]));
+  }
+
+  // Commands sent in non_blocking_read mode for cycles without new robot state. Either "hold" to
+  // repeat the last commands or "extrapolate" to continue the last position command linearly.
+  extrapolate_stale_commands_ = true;
+  if (info_.hardware_parameters.count("stale_command_mode")) {
+    const std::string stale_command_mode = info_.hardware_parameters["stale_command_mode"];
+    if (stale_command_mode != "hold" && stale_command_mode != "extrapolate") {
+      RCLCPP_FATAL(rclcpp::get_logger("URPositionHardwareInterface"),
+                   "Invalid stale_command_mode '%s', expected 'hold' or 'extrapolate'.", stale_command_mode.c_str());
+      return CallbackReturn::ERROR;
+    }
+    extrapolate_stale_commands_ = stale_command_mode == "extrapolate";
+  }
+
+  // Time in seconds without any RTDE package, after which the connection to the robot is considered
+  // lost and gets re-established in the background. Zero disables reconnecting.
+  reconnect_timeout_ = std::chrono::duration<double>(1.0);
+  if (info_.hardware_parameters.count("reconnect_timeout")) {
+    reconnect_timeout_ = std::chrono::duration<double>(stod(info_.hardware_parameters["reconnect_timeout"]));
+  }
+
+  RCLCPP_INFO(rclcpp::get_logger("URPositionHardwareInterface"), "Initializing driver...");
+  registerUrclLogHandler();
+  // the robot program connects to the trajectory socket as soon as it starts
+  if (trajectory_port_ > 0 && !trajectory_forwarder_.start(trajectory_port_)) {
+    unregisterUrclLogHandler();
+    return CallbackReturn::ERROR;
+  }
+  if (!connectToRobot()) {
+    // release whatever was created before connecting failed, the state stays DISCONNECTED so
+    // on_cleanup() would not do it
+    disconnectFromRobot();
+    trajectory_forwarder_.stop();
+    unregisterUrclLogHandler();
+    return CallbackReturn::ERROR;
+  }
+
+  packet_statistics_.reset();
+  reported_missed_packets_ = 0;
+  reconnects_ = 0.0;
+  last_recovery_duration_ = 0.0;
+  startRobotCommunication();
+  connection_state_ = ConnectionState::CONNECTED;
+
+  async_thread_shutdown_ = false;
+  async_thread_ = std::make_shared<std::thread>(&URPositionHardwareInterface::asyncThread, this);
+
+  return CallbackReturn::SUCCESS;
+}
+
+bool URPositionHardwareInterface::connectToRobot()
+{
+  // The robot's IP address.
+  std::string robot_ip = info_.hardware_parameters["robot_ip"];
+  // Path to the urscript code that will be sent to the robot
+  std::string script_filename = info_.hardware_parameters["script_filename"];
+  // Path to the file containing the recipe used for requesting RTDE outputs.
+  std::string output_recipe_filename;
+  // Path to the file containing the recipe used for requesting RTDE inputs.
+  std::string input_recipe_filename;
+  // Start robot in headless mode. This does not require the 'External Control' URCap to be running
   // on the robot, but this will send the URScript to the robot directly. On e-Series robots this
   // requires the robot to run in 'remote-control' mode.
   bool headless_mode =
@@ -287,17 +1254,11 @@ CallbackReturn URPositionHardwareInterface::on_activate(const rclcpp_lifecycle::
   //  std::string tf_prefix = info_.hardware_parameters["tf_prefix"];
   //  std::string tf_prefix;
 
-  // Enables non_blocking_read mode. Should only be used with combined_robot_hw. Disables error generated when read
-  // returns without any data, sets the read timeout to zero, and synchronises read/write operations. Enabling this when
-  // not used with combined_robot_hw can suppress important errors and affect real-time performance.
-  non_blocking_read_ = static_cast<bool>(stoi(info_.hardware_parameters["non_blocking_read"]));
-
-  // Specify gain for servoing to position in joint space.
-  // A higher gain can sharpen the trajectory.
-  int servoj_gain = stoi(info_.hardware_parameters["servoj_gain"]);
-  // Specify lookahead time for servoing to position in joint space.
-  // A longer lookahead time can smooth the trajectory.
-  double servoj_lookahead_time = stod(info_.hardware_parameters["servoj_lookahead_time"]);
+  // Gain and lookahead time for servoing to position in joint space. A higher gain can sharpen the
+  // trajectory, a longer lookahead time can smooth it. After a reconnect the robot program continues
+  // with the values changed at runtime.
+  int servoj_gain = static_cast<int>(servoj_gain_);
+  double servoj_lookahead_time = servoj_lookahead_time_;
 
   bool use_tool_communication = (info_.hardware_parameters["use_tool_communication"] == "true") ||
                                 (info_.hardware_parameters["use_tool_communication"] == "True");
@@ -369,8 +1330,35 @@ CallbackReturn URPositionHardwareInterface::on_activate(const rclcpp_lifecycle::
     tool_comm_setup->setTxIdleChars(tx_idle_chars);
   }
 
-  RCLCPP_INFO(rclcpp::get_logger("URPositionHardwareInterface"), "Initializing driver...");
-  registerUrclLogHandler();
+  // The client library only fills in its own placeholders, so the remaining ones are replaced in a
+  // copy of the script.
+  const auto script_start = std::chrono::steady_clock::now();
+  bool script_cached = false;
+  if (!prepareGeneratedFilesDirectory() || !prepareScript(script_filename, script_filename, script_cached)) {
+    return false;
+  }
+  // The recipes were extended by the registers in use, so they are passed on as files of their own.
+  const auto recipes_start = std::chrono::steady_clock::now();
+  if (!writeRecipe(output_recipe_, "output", output_recipe_filename) ||
+      !writeRecipe(input_recipe_, "input", input_recipe_filename)) {
+    return false;
+  }
+
+  // The low-rate RTDE connection does not depend on the driver, so it is set up while the driver
+  // connects to the robot. The future is declared after the duration it writes, so leaving early
+  // waits for it before the duration goes out of scope.
+  const auto driver_start = std::chrono::steady_clock::now();
+  std::chrono::steady_clock::duration slow_rtde_duration(0);
+  std::future<bool> slow_rtde_connected;
+  if (!slow_output_recipe_filename_.empty()) {
+    slow_rtde_connected = std::async(std::launch::async, [this, robot_ip, &slow_rtde_duration]() {
+      const auto start = std::chrono::steady_clock::now();
+      const bool connected = connectSlowRTDE(robot_ip);
+      slow_rtde_duration = std::chrono::steady_clock::now() - start;
+      return connected;
+    });
+  }
+
   try {
     ur_driver_ = std::make_unique<urcl::UrDriver>(
         robot_ip, script_filename, output_recipe_filename, input_recipe_filename,
@@ -380,108 +1368,527 @@ CallbackReturn URPositionHardwareInterface::on_activate(const rclcpp_lifecycle::
   } catch (urcl::ToolCommNotAvailable& e) {
     RCLCPP_FATAL_STREAM(rclcpp::get_logger("URPositionHardwareInterface"), "See parameter use_tool_communication");
 
-    return CallbackReturn::ERROR;
+    return false;
   } catch (urcl::UrException& e) {
-    RCLCPP_FATAL_STREAM(rclcpp::get_logger("URPositionHardwareInterface"), e.what());
-    return CallbackReturn::ERROR;
+    RCLCPP_ERROR_STREAM(rclcpp::get_logger("URPositionHardwareInterface"), e.what());
+    return false;
   }
+  const auto driver_end = std::chrono::steady_clock::now();
 
+  if (slow_rtde_connected.valid() && !slow_rtde_connected.get()) {
+    return false;
+  }
+
+  RCLCPP_INFO(rclcpp::get_logger("URPositionHardwareInterface"),
+              "Connected to the robot in %.0f ms: script %.1f ms%s, recipes %.1f ms, driver %.0f ms, low-rate RTDE "
+              "%.0f ms in parallel",
+              toMilliseconds(std::chrono::steady_clock::now() - script_start),
+              toMilliseconds(recipes_start - script_start), script_cached ? " (cached)" : "",
+              toMilliseconds(driver_start - recipes_start), toMilliseconds(driver_end - driver_start),
+              toMilliseconds(slow_rtde_duration));
+  return true;
+}
+
+bool URPositionHardwareInterface::connectSlowRTDE(const std::string& robot_ip)
+{
+  RCLCPP_INFO(rclcpp::get_logger("URPositionHardwareInterface"), "Starting low-rate RTDE connection at %.1f Hz",
+              slow_output_frequency_);
+  try {
+    slow_rtde_client_ = std::make_unique<rtde::RTDEClient>(robot_ip, slow_rtde_notifier_, slow_output_recipe_filename_,
+                                                           slow_input_recipe_filename_, slow_output_frequency_);
+    if (!slow_rtde_client_->init()) {
+      RCLCPP_ERROR(rclcpp::get_logger("URPositionHardwareInterface"),
+                   "Could not initialize the low-rate RTDE connection.");
+      return false;
+    }
+  } catch (urcl::UrException& e) {
+    RCLCPP_ERROR_STREAM(rclcpp::get_logger("URPositionHardwareInterface"), e.what());
+    return false;
+  }
+  return true;
+}
+
+bool URPositionHardwareInterface::prepareGeneratedFilesDirectory()
+{
+  if (!generated_files_directory_.empty() && std::filesystem::is_directory(generated_files_directory_)) {
+    return true;
+  }
+
+  // mkdtemp() creates a new directory with mode 0700 or fails, it never reuses an existing one
+  std::string directory = (std::filesystem::temp_directory_path() / "ur_robot_driver_XXXXXX").string();
+  if (mkdtemp(&directory[0]) == nullptr) {
+    RCLCPP_ERROR(rclcpp::get_logger("URPositionHardwareInterface"),
+                 "Could not create a directory for the generated script and recipes: %s", strerror(errno));
+    return false;
+  }
+  generated_files_directory_ = directory;
+  prepared_script_key_.clear();
+  written_recipes_.clear();
+  return true;
+}
+
+bool URPositionHardwareInterface::prepareScript(const std::string& script_filename, std::string& prepared_filename,
+                                                bool& cached)
+{
+  const std::vector<std::pair<const char*, std::string>> replacements = {
+    { LATENCY_PROBE_REGISTER_REPLACE, std::to_string(latency_probe_register_) },
+    { COMMAND_TRACKING_REGISTER_REPLACE, std::to_string(command_tracking_register_) },
+    { PAYLOAD_REGISTER_REPLACE, std::to_string(payload_register_) },
+    { TRAJECTORY_PORT_REPLACE, std::to_string(trajectory_port_) },
+    { SERVOJ_PARAMETER_REGISTER_REPLACE, std::to_string(servoj_parameter_register_) },
+    { FORCE_MODE_REGISTER_REPLACE, std::to_string(force_mode_register_) },
+    { SERVOJ_GAIN_REPLACE, toScriptValue(servoj_gain_) },
+    { SERVOJ_LOOKAHEAD_TIME_REPLACE, toScriptValue(servoj_lookahead_time_) },
+    { SERVO_EXTRAPOLATION_MODE_REPLACE, std::to_string(static_cast<int>(servo_extrapolation_mode_)) },
+    { SERVO_EXTRAPOLATION_MAX_STEPS_REPLACE, std::to_string(servo_extrapolation_max_steps_) },
+    { SERVO_EXTRAPOLATION_MAX_VELOCITY_REPLACE, toScriptValue(servo_extrapolation_max_velocity_) },
+    { SERVO_EXTRAPOLATION_MAX_ACCELERATION_REPLACE, toScriptValue(servo_extrapolation_max_acceleration_) },
+  };
+
+  const std::filesystem::path prepared_path =
+      std::filesystem::path(generated_files_directory_) / "ros_control.urscript";
+
+  // The prepared script only changes with the template and the replaced values
+  std::error_code error;
+  const auto template_time = std::filesystem::last_write_time(script_filename, error);
+  std::string key = script_filename + "\n" + std::to_string(template_time.time_since_epoch().count());
+  for (const auto& replacement : replacements) {
+    key += "\n" + replacement.second;
+  }
+  cached = !error && key == prepared_script_key_ && std::filesystem::exists(prepared_path);
+  if (cached) {
+    prepared_filename = prepared_path.string();
+    return true;
+  }
+  prepared_script_key_.clear();
+
+  std::ifstream script_file(script_filename);
+  if (!script_file.is_open()) {
+    RCLCPP_ERROR(rclcpp::get_logger("URPositionHardwareInterface"), "Could not open script file '%s'.",
+                 script_filename.c_str());
+    return false;
+  }
+  std::stringstream buffer;
+  buffer << script_file.rdbuf();
+  std::string script = buffer.str();
+
+  for (const auto& replacement : replacements) {
+    replaceAll(script, replacement.first, replacement.second);
+  }
+
+  std::ofstream prepared_file(prepared_path, std::ios::trunc);
+  prepared_file << script;
+  if (!prepared_file) {
+    RCLCPP_ERROR(rclcpp::get_logger("URPositionHardwareInterface"), "Could not write script file '%s'.",
+                 prepared_path.c_str());
+    return false;
+  }
+  if (!error) {
+    prepared_script_key_ = key;
+  }
+  prepared_filename = prepared_path.string();
+  return true;
+}
+
+bool URPositionHardwareInterface::writeRecipe(const std::vector<std::string>& recipe, const std::string& recipe_name,
+                                              std::string& recipe_filename)
+{
+  const std::filesystem::path recipe_path =
+      std::filesystem::path(generated_files_directory_) / ("rtde_" + recipe_name + "_recipe.txt");
+  recipe_filename = recipe_path.string();
+
+  std::string content;
+  for (const std::string& field : recipe) {
+    content += field + "\n";
+  }
+  auto written = written_recipes_.find(recipe_filename);
+  if (written != written_recipes_.end() && written->second == content && std::filesystem::exists(recipe_path)) {
+    return true;
+  }
+  written_recipes_.erase(recipe_filename);
+
+  std::ofstream recipe_file(recipe_path, std::ios::trunc);
+  recipe_file << content;
+  recipe_file.flush();
+  if (!recipe_file) {
+    RCLCPP_ERROR(rclcpp::get_logger("URPositionHardwareInterface"), "Could not write recipe file '%s'.",
+                 recipe_path.c_str());
+    return false;
+  }
+  written_recipes_[recipe_filename] = content;
+  return true;
+}
+
+void URPositionHardwareInterface::startRobotCommunication()
+{
+  last_package_time_ = std::chrono::steady_clock::now();
   ur_driver_->startRTDECommunication();
 
-  async_thread_ = std::make_shared<std::thread>(&URPositionHardwareInterface::asyncThread, this);
+  if (slow_rtde_client_) {
+    slow_rtde_thread_shutdown_ = false;
+    slow_rtde_client_->start();
+    slow_rtde_thread_ = std::make_shared<std::thread>(&URPositionHardwareInterface::slowRTDEThread, this);
+  }
+}
 
-  RCLCPP_INFO(rclcpp::get_logger("URPositionHardwareInterface"), "System successfully started!");
+void URPositionHardwareInterface::disconnectFromRobot()
+{
+  if (slow_rtde_thread_) {
+    slow_rtde_thread_shutdown_ = true;
+    slow_rtde_thread_->join();
+    slow_rtde_thread_.reset();
+  }
+  slow_rtde_client_.reset();
+  std::unique_ptr<rtde::DataPackage> slow_pkg;
+  while (slow_packages_.pop(slow_pkg)) {
+    slow_pkg.reset();
+  }
 
-  return CallbackReturn::SUCCESS;
+  ur_driver_.reset();
+}
+
+void URPositionHardwareInterface::reconnectToRobot()
+{
+  RCLCPP_WARN(rclcpp::get_logger("URPositionHardwareInterface"),
+              "No RTDE package received for %.1f s. Reconnecting to the robot...", reconnect_timeout_.count());
+  connection_state_ = ConnectionState::RECONNECTING;
+  disconnectFromRobot();
+
+  std::chrono::milliseconds backoff = RECONNECT_MIN_BACKOFF;
+  while (!async_thread_shutdown_) {
+    if (connectToRobot()) {
+      startRobotCommunication();
+      // the control thread re-syncs the commands with the first package of the new connection
+      connection_state_ = ConnectionState::RESYNCING;
+      RCLCPP_INFO(rclcpp::get_logger("URPositionHardwareInterface"), "Reconnected to the robot.");
+      return;
+    }
+    // release whatever was created before the attempt failed
+    disconnectFromRobot();
+
+    RCLCPP_WARN(rclcpp::get_logger("URPositionHardwareInterface"), "Reconnecting failed, next attempt in %ld ms.",
+                static_cast<long>(backoff.count()));
+    const auto next_attempt = std::chrono::steady_clock::now() + backoff;
+    while (!async_thread_shutdown_ && std::chrono::steady_clock::now() < next_attempt) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    backoff = std::min(2 * backoff, RECONNECT_MAX_BACKOFF);
+  }
 }
 
 CallbackReturn URPositionHardwareInterface::on_deactivate(const rclcpp_lifecycle::State& previous_state)
 {
   RCLCPP_INFO(rclcpp::get_logger("URPositionHardwareInterface"), "Stopping ...please wait...");
 
-  async_thread_shutdown_ = true;
-  async_thread_->join();
-  async_thread_.reset();
-
-  ur_driver_.reset();
+  if (warm_standby_) {
+    // Only commanding stops. The keepalives of writeStandby() switch the robot program to idle, which
+    // stops the arm and ends a forwarded trajectory.
+    position_controller_running_ = false;
+    velocity_controller_running_ = false;
+    twist_controller_running_ = false;
+    trajectory_forwarding_running_ = false;
+    force_mode_running_ = false;
+    if (trajectory_active_) {
+      finishTrajectory(TrajectoryResult::CANCELED);
+    }
+    standby_ = true;
+    RCLCPP_INFO(rclcpp::get_logger("URPositionHardwareInterface"),
+                "System stopped, the connection to the robot is kept for warm standby.");
+    return CallbackReturn::SUCCESS;
+  }
 
-  unregisterUrclLogHandler();
+  stopDriver();
 
   RCLCPP_INFO(rclcpp::get_logger("URPositionHardwareInterface"), "System successfully stopped!");
 
   return CallbackReturn::SUCCESS;
 }
 
-template <typename T>
-void URPositionHardwareInterface::readData(const std::unique_ptr<rtde::DataPackage>& data_pkg,
-                                           const std::string& var_name, T& data)
+void URPositionHardwareInterface::stopDriver()
 {
-  if (!data_pkg->getData(var_name, data)) {
-    // This throwing should never happen unless misconfigured
-    std::string error_msg = "Did not find '" + var_name + "' in data sent from robot. This should not happen!";
-    throw std::runtime_error(error_msg);
+  if (async_thread_) {
+    async_thread_shutdown_ = true;
+    async_mailbox_.wake();
+    async_thread_->join();
+    async_thread_.reset();
   }
+  connection_state_ = ConnectionState::DISCONNECTED;
+  disconnectFromRobot();
+  trajectory_forwarder_.stop();
+  package_recycler_.drain();
+
+  unregisterUrclLogHandler();
+}
+
+void URPositionHardwareInterface::writeStandby()
+{
+  if (connection_state_ != ConnectionState::CONNECTED || !robot_program_running_) {
+    return;
+  }
+  if (force_mode_register_ >= 0) {
+    writeForceMode();
+    postStreamedRegisters();
+  }
+  ur_driver_->writeKeepalive();
 }
 
-template <typename T, size_t N>
-void URPositionHardwareInterface::readBitsetData(const std::unique_ptr<rtde::DataPackage>& data_pkg,
-                                                 const std::string& var_name, std::bitset<N>& data)
+bool URPositionHardwareInterface::bindOutputRecipe(const std::vector<std::string>& output_recipe,
+                                                   const std::vector<std::string>& slow_output_recipe)
 {
-  if (!data_pkg->getData<T, N>(var_name, data)) {
-    // This throwing should never happen unless misconfigured
-    std::string error_msg = "Did not find '" + var_name + "' in data sent from robot. This should not happen!";
-    throw std::runtime_error(error_msg);
+  output_binding_.clear();
+  generic_output_fields_.clear();
+  slow_output_binding_.clear();
+  generic_slow_output_fields_.clear();
+  for (const std::string& field : output_recipe) {
+    if (!bindOutputField(field, output_binding_, generic_output_fields_)) {
+      return false;
+    }
+  }
+  for (const std::string& field : slow_output_recipe) {
+    if (output_binding_.contains(field)) {
+      RCLCPP_FATAL(rclcpp::get_logger("URPositionHardwareInterface"),
+                   "RTDE field '%s' is part of both the output recipe and the slow output recipe.", field.c_str());
+      return false;
+    }
+    if (!bindOutputField(field, slow_output_binding_, generic_slow_output_fields_)) {
+      return false;
+    }
+  }
+
+  // the required fields are used for motion, so they have to arrive with every control cycle
+  for (const std::string& field : REQUIRED_OUTPUT_FIELDS) {
+    if (!output_binding_.contains(field)) {
+      RCLCPP_FATAL(rclcpp::get_logger("URPositionHardwareInterface"),
+                   "RTDE output recipe does not contain required field '%s'.", field.c_str());
+      return false;
+    }
   }
+
+  tcp_pose_in_recipe_ = output_binding_.contains("actual_TCP_pose");
+  tcp_force_in_recipe_ = output_binding_.contains("actual_TCP_force");
+  timestamp_in_recipe_ = output_binding_.contains("timestamp");
+  if (slow_output_binding_.contains("actual_TCP_pose") || slow_output_binding_.contains("actual_TCP_force") ||
+      slow_output_binding_.contains("timestamp")) {
+    RCLCPP_FATAL(rclcpp::get_logger("URPositionHardwareInterface"),
+                 "The timestamp, TCP pose and wrench cannot be part of the slow output recipe.");
+    return false;
+  }
+
+  return true;
+}
+
+bool URPositionHardwareInterface::bindOutputField(const std::string& field, RTDEOutputBinding& binding,
+                                                  std::vector<std::unique_ptr<GenericRTDEField>>& generic_fields)
+{
+  if (field == "timestamp") {
+    binding.bind(field, &robot_timestamp_);
+  } else if (!latency_probe_output_field_.empty() && field == latency_probe_output_field_) {
+    binding.bind(field, &latency_probe_echo_);
+  } else if (!payload_output_field_.empty() && field == payload_output_field_) {
+    binding.bind(field, &payload_echo_);
+  } else if (isCommandTrackingField(field)) {
+    binding.bind(field, &command_tracking_outputs_[std::stoi(field.substr(field.rfind('_') + 1)) -
+                                                   command_tracking_register_]);
+  } else if (field == "actual_q") {
+    binding.bind(field, &urcl_joint_positions_);
+  } else if (field == "actual_qd") {
+    binding.bind(field, &urcl_joint_velocities_);
+  } else if (field == "actual_current") {
+    binding.bind(field, &urcl_joint_efforts_);
+  } else if (field == "target_speed_fraction") {
+    binding.bind(field, &target_speed_fraction_);
+  } else if (field == "speed_scaling") {
+    binding.bind(field, &speed_scaling_);
+  } else if (field == "runtime_state") {
+    binding.bind(field, &runtime_state_);
+  } else if (field == "actual_TCP_force") {
+    binding.bind(field, &urcl_ft_sensor_measurements_);
+  } else if (field == "actual_TCP_pose") {
+    binding.bind(field, &urcl_tcp_pose_);
+  } else if (field == "standard_analog_input0") {
+    binding.bind(field, &standard_analog_input_[0]);
+  } else if (field == "standard_analog_input1") {
+    binding.bind(field, &standard_analog_input_[1]);
+  } else if (field == "standard_analog_output0") {
+    binding.bind(field, &standard_analog_output_[0]);
+  } else if (field == "standard_analog_output1") {
+    binding.bind(field, &standard_analog_output_[1]);
+  } else if (field == "tool_mode") {
+    binding.bind(field, &tool_mode_);
+  } else if (field == "tool_analog_input0") {
+    binding.bind(field, &tool_analog_input_[0]);
+  } else if (field == "tool_analog_input1") {
+    binding.bind(field, &tool_analog_input_[1]);
+  } else if (field == "tool_output_voltage") {
+    binding.bind(field, &tool_output_voltage_);
+  } else if (field == "tool_output_current") {
+    binding.bind(field, &tool_output_current_);
+  } else if (field == "tool_temperature") {
+    binding.bind(field, &tool_temperature_);
+  } else if (field == "robot_mode") {
+    binding.bind(field, &robot_mode_);
+  } else if (field == "safety_mode") {
+    binding.bind(field, &safety_mode_);
+  } else if (field == "robot_status_bits") {
+    binding.bind(field, &robot_status_bits_);
+  } else if (field == "safety_status_bits") {
+    binding.bind(field, &safety_status_bits_);
+  } else if (field == "actual_digital_input_bits") {
+    binding.bind(field, &actual_dig_in_bits_);
+  } else if (field == "actual_digital_output_bits") {
+    binding.bind(field, &actual_dig_out_bits_);
+  } else if (field == "analog_io_types") {
+    binding.bind(field, &analog_io_types_);
+  } else if (field == "tool_analog_input_types") {
+    binding.bind(field, &tool_analog_input_types_);
+  } else {
+    RTDEFieldType type;
+    if (!RTDEOutputBinding::lookupFieldType(field, type)) {
+      RCLCPP_FATAL(rclcpp::get_logger("URPositionHardwareInterface"),
+                   "RTDE output recipe contains unknown field '%s'.", field.c_str());
+      return false;
+    }
+    generic_fields.emplace_back(std::make_unique<GenericRTDEField>(field, type));
+    generic_fields.back()->bindTo(binding);
+  }
+  return true;
+}
+
+bool URPositionHardwareInterface::isCommandTrackingField(const std::string& field) const
+{
+  return std::find(command_tracking_output_fields_.begin(), command_tracking_output_fields_.end(), field) !=
+         command_tracking_output_fields_.end();
+}
+
+bool URPositionHardwareInterface::isOutputFieldStreamed(const std::string& field) const
+{
+  return output_binding_.contains(field) || slow_output_binding_.contains(field);
 }
 
 void URPositionHardwareInterface::asyncThread()
 {
   while (!async_thread_shutdown_) {
-    if (initialized_) {
-      //        RCLCPP_INFO(rclcpp::get_logger("URPositionHardwareInterface"), "Initialized in async thread");
-      checkAsyncIO();
+    if (connection_state_ == ConnectionState::LOST) {
+      reconnectToRobot();
+      continue;
+    }
+    processAsyncCommands();
+    sendStreamedRegisters();
+    if (latency_probe_register_ >= 0) {
+      sendLatencyProbe();
+    }
+    package_recycler_.drain();
+
+    // report lost packages here, logging is not an option in the control thread
+    const uint64_t missed_packets = packet_statistics_.getMissedPackets();
+    if (missed_packets > reported_missed_packets_) {
+      RCLCPP_WARN(rclcpp::get_logger("URPositionHardwareInterface"),
+                  "Lost %lu RTDE packages, largest gap between two packages so far: %.1f ms",
+                  missed_packets - reported_missed_packets_, packet_statistics_.getMaxGap() * 1000.0);
+      reported_missed_packets_ = missed_packets;
+    }
+
+    // the control thread records the round trips, evaluating them is left to this thread
+    if (latency_probe_register_ >= 0 &&
+        std::chrono::steady_clock::now() - last_latency_probe_evaluation_ >= std::chrono::seconds(1)) {
+      const LatencyHistogram::Snapshot snapshot = latency_probe_histogram_.snapshot();
+      if (snapshot.count > 0) {
+        latency_probe_p50_us_ = snapshot.percentile(0.5) / 1000.0;
+        latency_probe_p99_us_ = snapshot.percentile(0.99) / 1000.0;
+        latency_probe_max_us_ = snapshot.max / 1000.0;
+      }
+      last_latency_probe_evaluation_ = std::chrono::steady_clock::now();
+    }
+
+    // Posting a command wakes this thread right away, the timeout only paces the housekeeping above.
+    async_mailbox_.wait(std::chrono::milliseconds(20));
+  }
+}
+
+void URPositionHardwareInterface::slowRTDEThread()
+{
+  while (!slow_rtde_thread_shutdown_) {
+    std::unique_ptr<rtde::DataPackage> data_pkg = slow_rtde_client_->getDataPackage(std::chrono::milliseconds(100));
+    // If the control thread did not pick up the previous packages, this one is dropped here. The
+    // next one carries the current values anyway.
+    if (data_pkg) {
+      slow_packages_.push(std::move(data_pkg));
     }
-    std::this_thread::sleep_for(std::chrono::nanoseconds(20000000));
+  }
+}
+
+void URPositionHardwareInterface::readSlowOutputs()
+{
+  std::unique_ptr<rtde::DataPackage> data_pkg;
+  if (!slow_packages_.pop(data_pkg)) {
+    return;
+  }
+
+  // only the most recent package is of interest
+  std::unique_ptr<rtde::DataPackage> newer_pkg;
+  while (slow_packages_.pop(newer_pkg)) {
+    package_recycler_.recycle(std::move(data_pkg));
+    data_pkg = std::move(newer_pkg);
+  }
+
+  slow_output_binding_.decode(*data_pkg);
+  package_recycler_.recycle(std::move(data_pkg));
+
+  for (auto& field : generic_slow_output_fields_) {
+    field->update();
   }
 }
 
 hardware_interface::return_type URPositionHardwareInterface::read(const rclcpp::Time & time, const rclcpp::Duration & period)
 {
-  std::unique_ptr<rtde::DataPackage> data_pkg = ur_driver_->getDataPackage();
+  // While the async thread re-establishes the connection, there is no driver to read from.
+  const ConnectionState connection_state = connection_state_;
+  robot_connected_ = connection_state == ConnectionState::CONNECTED ? 1.0 : 0.0;
+  if (connection_state != ConnectionState::CONNECTED && connection_state != ConnectionState::RESYNCING) {
+    packet_read_ = false;
+    stale_cycles_ += 1.0;
+    consecutive_stale_cycles_ += 1.0;
+    return hardware_interface::return_type::OK;
+  }
+
+  std::unique_ptr<rtde::DataPackage> data_pkg = fetchDataPackage();
+  const auto now = std::chrono::steady_clock::now();
 
   if (data_pkg) {
     packet_read_ = true;
-    readData(data_pkg, "actual_q", urcl_joint_positions_);
-    readData(data_pkg, "actual_qd", urcl_joint_velocities_);
-    readData(data_pkg, "actual_current", urcl_joint_efforts_);
-
-    readData(data_pkg, "target_speed_fraction", target_speed_fraction_);
-    readData(data_pkg, "speed_scaling", speed_scaling_);
-    readData(data_pkg, "runtime_state", runtime_state_);
-    readData(data_pkg, "actual_TCP_force", urcl_ft_sensor_measurements_);
-    readData(data_pkg, "actual_TCP_pose", urcl_tcp_pose_);
-    readData(data_pkg, "standard_analog_input0", standard_analog_input_[0]);
-    readData(data_pkg, "standard_analog_input1", standard_analog_input_[1]);
-    readData(data_pkg, "standard_analog_output0", standard_analog_output_[0]);
-    readData(data_pkg, "standard_analog_output1", standard_analog_output_[1]);
-    readData(data_pkg, "tool_mode", tool_mode_);
-    readData(data_pkg, "tool_analog_input0", tool_analog_input_[0]);
-    readData(data_pkg, "tool_analog_input1", tool_analog_input_[1]);
-    readData(data_pkg, "tool_output_voltage", tool_output_voltage_);
-    readData(data_pkg, "tool_output_current", tool_output_current_);
-    readData(data_pkg, "tool_temperature", tool_temperature_);
-    readData(data_pkg, "robot_mode", robot_mode_);
-    readData(data_pkg, "safety_mode", safety_mode_);
-    readBitsetData<uint32_t>(data_pkg, "robot_status_bits", robot_status_bits_);
-    readBitsetData<uint32_t>(data_pkg, "safety_status_bits", safety_status_bits_);
-    readBitsetData<uint64_t>(data_pkg, "actual_digital_input_bits", actual_dig_in_bits_);
-    readBitsetData<uint64_t>(data_pkg, "actual_digital_output_bits", actual_dig_out_bits_);
-    readBitsetData<uint32_t>(data_pkg, "analog_io_types", analog_io_types_);
-    readBitsetData<uint32_t>(data_pkg, "tool_analog_input_types", tool_analog_input_types_);
-
-    // required transforms
-    extractToolPose();
-    transformForceTorque();
+    consecutive_stale_cycles_ = 0.0;
+    last_package_time_ = now;
+    output_binding_.decode(*data_pkg);
+    if (timestamp_in_recipe_) {
+      packet_statistics_.update(robot_timestamp_, now);
+    }
+    if (latency_probe_register_ >= 0 || command_tracking_register_ >= 0) {
+      collectSentSequences();
+    }
+    if (latency_probe_register_ >= 0) {
+      readLatencyProbe(now);
+    }
+    if (command_tracking_register_ >= 0) {
+      readCommandTracking(now);
+    }
+    if (payload_pending_) {
+      readPayloadConfirmation(now);
+    }
+    // hand the package over to the async thread instead of freeing it in the control loop
+    package_recycler_.recycle(std::move(data_pkg));
+
+    for (auto& field : generic_output_fields_) {
+      field->update();
+    }
+
+    if (slow_rtde_client_) {
+      readSlowOutputs();
+    }
+
+    // the wrench is reported in base coordinates, the sensor interfaces provide it in tool coordinates
+    if (transform_wrench_) {
+      transformWrenchToTool(urcl_tcp_pose_, urcl_ft_sensor_measurements_);
+    }
 
     // TODO(anyone): logic for sending other stuff to higher level interface
 
@@ -516,45 +1923,631 @@ hardware_interface::return_type URPositionHardwareInterface::read(const rclcpp::
       // initialize commands
       urcl_position_commands_ = urcl_position_commands_old_ = urcl_joint_positions_;
       urcl_velocity_commands_ = { { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 } };
+      urcl_twist_commands_ = { { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 } };
+      resetStaleCommands();
       target_speed_fraction_cmd_ = NO_NEW_CMD_;
       resend_robot_program_cmd_ = NO_NEW_CMD_;
+      resendRegisterCommands();
       initialized_ = true;
     }
 
+    if (connection_state == ConnectionState::RESYNCING) {
+      // Continue from where the robot is now. Commands from before the connection loss are outdated.
+      initAsyncIO();
+      urcl_position_commands_ = urcl_position_commands_old_ = urcl_joint_positions_;
+      urcl_velocity_commands_ = { { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 } };
+      urcl_twist_commands_ = { { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 } };
+      resetStaleCommands();
+      resendRegisterCommands();
+      reconnects_ += 1.0;
+      last_recovery_duration_ = std::chrono::duration<double>(now - connection_lost_time_).count();
+      connection_state_ = ConnectionState::CONNECTED;
+      robot_connected_ = 1.0;
+    }
+
+    if (standby_) {
+      writeStandby();
+    }
+
     updateNonDoubleValues();
 
     return hardware_interface::return_type::OK;
   }
 
-  RCLCPP_ERROR(rclcpp::get_logger("URPositionHardwareInterface"), "Unable to read from hardware...");
-  // TODO(anyone): could not read from the driver --> return ERROR --> on error will be called
+  // The state of this cycle is the one of the last package. In non-blocking mode this is expected to
+  // happen every now and then, otherwise the connection to the robot is in trouble.
+  stale_cycles_ += 1.0;
+  consecutive_stale_cycles_ += 1.0;
+  if (!non_blocking_read_) {
+    RCLCPP_ERROR(rclcpp::get_logger("URPositionHardwareInterface"), "Unable to read from hardware...");
+  }
+
+  // Without packages for too long, the async thread replaces the connection to the robot.
+  if (reconnect_timeout_.count() > 0.0 && now - last_package_time_ > reconnect_timeout_) {
+    connection_lost_time_ = last_package_time_;
+    connection_state_ = ConnectionState::LOST;
+  }
   return hardware_interface::return_type::OK;
 }
 
+std::unique_ptr<rtde::DataPackage> URPositionHardwareInterface::fetchDataPackage()
+{
+  std::unique_ptr<rtde::DataPackage> data_pkg = ur_driver_->getDataPackage();
+  if (data_pkg || !non_blocking_read_ || read_budget_.count() <= 0.0) {
+    return data_pkg;
+  }
+
+  // The driver does not wait for packages in non-blocking mode, so poll until the budget is used up.
+  const auto deadline = std::chrono::steady_clock::now() + read_budget_;
+  while (!data_pkg && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::microseconds(50));
+    data_pkg = ur_driver_->getDataPackage();
+  }
+  return data_pkg;
+}
+
 hardware_interface::return_type URPositionHardwareInterface::write(const rclcpp::Time & time, const rclcpp::Duration & period)
 {
+  // in warm standby read() keeps the robot program alive and no controller is active
+  if (standby_) {
+    return hardware_interface::return_type::OK;
+  }
+
+  // The controllers wrote their requests during the update, so they are handed to the async thread
+  // right away.
+  collectAsyncResults();
+  if (initialized_) {
+    dispatchAsyncCommands();
+  }
+  if (trajectory_port_ > 0) {
+    readTrajectoryReports();
+  }
+  if (mode_switch_pending_) {
+    ++mode_switch_write_cycles_;
+  }
+
+  // nothing is sent before the commands were re-synced after a reconnect
+  if (connection_state_ != ConnectionState::CONNECTED) {
+    return hardware_interface::return_type::OK;
+  }
+
+  // the async thread sends the probes and records the cycle they were sent in
+  if (latency_probe_register_ >= 0 && robot_program_running_) {
+    latency_probe_write_cycles_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // the registers are read by the robot program, but they are written independently of it
+  writeRegisterCommands();
+  if (servoj_parameter_register_ >= 0) {
+    writeServojParameters();
+  }
+  if (force_mode_register_ >= 0) {
+    writeForceMode();
+  }
+
   // If there is no interpreting program running on the robot, we do not want to send anything.
   // TODO(anyone): We would still like to disable the controllers requiring a writable interface. In ROS1
   // this was done externally using the controller_stopper.
-  if ((runtime_state_ == static_cast<uint32_t>(rtde::RUNTIME_STATE::PLAYING) ||
-       runtime_state_ == static_cast<uint32_t>(rtde::RUNTIME_STATE::PAUSING)) &&
-      robot_program_running_ && (!non_blocking_read_ || packet_read_)) {
+  const bool program_playing = (runtime_state_ == static_cast<uint32_t>(rtde::RUNTIME_STATE::PLAYING) ||
+                                runtime_state_ == static_cast<uint32_t>(rtde::RUNTIME_STATE::PAUSING)) &&
+                               robot_program_running_;
+  if (program_playing && command_tracking_register_ >= 0) {
+    writeCommandSequence();
+  }
+  // only posted if something changed
+  postStreamedRegisters();
+
+  if (program_playing) {
+    if (servoj_lookahead_adaptive_ && position_controller_running_) {
+      adaptServojLookahead();
+    }
+
+    // the robot program interpolates forwarded trajectories itself, so there is nothing to bridge
+    if (non_blocking_read_ && !packet_read_ && !trajectory_forwarding_running_ && !trajectory_active_) {
+      writeStaleCommands();
+      return hardware_interface::return_type::OK;
+    }
+
     if (position_controller_running_) {
+      // per-cycle change of the command, spread over the stale cycles since the last write
+      const double cycles = static_cast<double>(stale_cycles_since_write_ + 1);
+      for (size_t i = 0; i < 6; ++i) {
+        position_command_step_[i] = (urcl_position_commands_[i] - urcl_position_commands_old_[i]) / cycles;
+      }
+      urcl_position_commands_old_ = urcl_position_commands_;
       ur_driver_->writeJointCommand(urcl_position_commands_, urcl::comm::ControlMode::MODE_SERVOJ);
 
     } else if (velocity_controller_running_) {
+      urcl_velocity_commands_old_ = urcl_velocity_commands_;
       ur_driver_->writeJointCommand(urcl_velocity_commands_, urcl::comm::ControlMode::MODE_SPEEDJ);
 
+    } else if (twist_controller_running_) {
+      urcl_twist_commands_old_ = urcl_twist_commands_;
+      ur_driver_->writeJointCommand(urcl_twist_commands_, urcl::comm::ControlMode::MODE_SPEEDL);
+
+    } else if (trajectory_forwarding_running_ || trajectory_active_) {
+      writeTrajectoryForwarding();
+
     } else {
       ur_driver_->writeKeepalive();
     }
 
+    if (mode_switch_pending_) {
+      finishModeSwitch();
+    }
+    stale_cycles_since_write_ = 0;
+    last_command_write_time_ = std::chrono::steady_clock::now();
     packet_read_ = false;
   }
 
   return hardware_interface::return_type::OK;
 }
 
+void URPositionHardwareInterface::sendLatencyProbe()
+{
+  const auto now = std::chrono::steady_clock::now();
+  if (ur_driver_ == nullptr || connection_state_ != ConnectionState::CONNECTED || !robot_program_running_ ||
+      now - last_latency_probe_send_ < LATENCY_PROBE_PERIOD) {
+    return;
+  }
+  const int32_t seq = latency_probe_seq_ == std::numeric_limits<int32_t>::max() ? 1 : latency_probe_seq_ + 1;
+  const uint64_t write_cycle = latency_probe_write_cycles_.load(std::memory_order_relaxed);
+  if (!ur_driver_->getRTDEWriter().sendInputIntRegister(latency_probe_register_, seq)) {
+    return;
+  }
+  latency_probe_seq_ = seq;
+  last_latency_probe_send_ = now;
+  async_mailbox_.postSentSequence({ SentSequence::Type::LATENCY_PROBE, seq, now, write_cycle });
+}
+
+void URPositionHardwareInterface::readLatencyProbe(std::chrono::steady_clock::time_point now)
+{
+  if (latency_probe_echo_ <= 0 || latency_probe_echo_ == latency_probe_last_echo_) {
+    return;
+  }
+
+  // Echoes older than the sample buffer have been overwritten already and cannot be matched. A sample
+  // the async thread did not report yet is matched in a later cycle.
+  const SequenceSample& sample = latency_probe_samples_[latency_probe_echo_ % latency_probe_samples_.size()];
+  if (sample.seq != latency_probe_echo_) {
+    return;
+  }
+  latency_probe_last_echo_ = latency_probe_echo_;
+  const auto round_trip = now - sample.send_time;
+  latency_probe_round_trip_cycles_ = static_cast<double>(
+      latency_probe_write_cycles_.load(std::memory_order_relaxed) - sample.write_cycle);
+  latency_probe_round_trip_us_ = std::chrono::duration<double, std::micro>(round_trip).count();
+  latency_probe_histogram_.record(round_trip);
+}
+
+void URPositionHardwareInterface::writeRegisterCommands()
+{
+  // a register keeps its value until a new command arrives
+  for (size_t i = 0; i < register_commands_.size(); ++i) {
+    if (!std::isnan(register_commands_[i].command)) {
+      streamed_registers_.register_values[i] = register_commands_[i].command;
+    }
+  }
+}
+
+void URPositionHardwareInterface::sendRegisterCommands(const StreamedRegisters& registers)
+{
+  rtde::RTDEWriter& writer = ur_driver_->getRTDEWriter();
+  // the robot keeps the value of a register, so it is only sent when it changes
+  for (size_t i = 0; i < register_commands_.size(); ++i) {
+    const double value = registers.register_values[i];
+    if (std::isnan(value) || value == register_values_sent_[i]) {
+      continue;
+    }
+    const RegisterCommand& register_command = register_commands_[i];
+    bool sent = false;
+    switch (register_command.type) {
+      case RTDEFieldType::BOOL:
+        sent = writer.sendInputBitRegister(register_command.index, static_cast<bool>(value));
+        break;
+      case RTDEFieldType::INT32:
+        sent = writer.sendInputIntRegister(register_command.index, static_cast<int32_t>(value));
+        break;
+      case RTDEFieldType::DOUBLE:
+        sent = writer.sendInputDoubleRegister(register_command.index, value);
+        break;
+      default:
+        break;
+    }
+    if (sent) {
+      register_values_sent_[i] = value;
+    }
+  }
+}
+
+void URPositionHardwareInterface::resendRegisterCommands()
+{
+  // the async thread owns what it sent of the streamed registers
+  streamed_registers_.resend = true;
+}
+
+void URPositionHardwareInterface::writeServojParameters()
+{
+  // values out of range are clamped, the state interfaces show what the robot actually uses
+  if (!std::isnan(servoj_gain_cmd_)) {
+    servoj_gain_ = std::clamp(servoj_gain_cmd_, SERVOJ_GAIN_MIN, SERVOJ_GAIN_MAX);
+    servoj_gain_cmd_ = NO_NEW_CMD_;
+  }
+  if (!std::isnan(servoj_lookahead_time_cmd_)) {
+    servoj_lookahead_time_ =
+        std::clamp(servoj_lookahead_time_cmd_, SERVOJ_LOOKAHEAD_TIME_MIN, SERVOJ_LOOKAHEAD_TIME_MAX);
+    servoj_lookahead_time_cmd_ = NO_NEW_CMD_;
+  }
+  streamed_registers_.servoj_gain = servoj_gain_;
+  streamed_registers_.servoj_lookahead_time = servoj_lookahead_time_;
+}
+
+void URPositionHardwareInterface::sendServojParameters(const StreamedRegisters& registers)
+{
+  rtde::RTDEWriter& writer = ur_driver_->getRTDEWriter();
+  // the adaptive lookahead time changes without the gain, so each value is only sent when it changes
+  if (!std::isnan(registers.servoj_gain) && registers.servoj_gain != servoj_gain_sent_ &&
+      writer.sendInputDoubleRegister(servoj_parameter_register_, registers.servoj_gain)) {
+    servoj_gain_sent_ = registers.servoj_gain;
+  }
+  if (!std::isnan(registers.servoj_lookahead_time) && registers.servoj_lookahead_time != servoj_lookahead_time_sent_ &&
+      writer.sendInputDoubleRegister(servoj_parameter_register_ + 1, registers.servoj_lookahead_time)) {
+    servoj_lookahead_time_sent_ = registers.servoj_lookahead_time;
+  }
+}
+
+void URPositionHardwareInterface::writeForceMode()
+{
+  for (size_t i = 0; i < streamed_registers_.force_mode_values.size(); ++i) {
+    streamed_registers_.force_mode_values[i] =
+        i < 6 ? force_mode_task_frame_[i] : i < 12 ? force_mode_wrench_[i - 6] : force_mode_limits_[i - 12];
+  }
+
+  int32_t selection = 0;
+  for (size_t i = 0; i < 6; ++i) {
+    if (force_mode_selection_[i] != 0.0) {
+      selection |= 1 << i;
+    }
+  }
+  streamed_registers_.force_mode_selection = selection;
+
+  // types force_mode does not know switch force mode off
+  int32_t type = 0;
+  if (force_mode_running_ && force_mode_type_ >= 0.5 && force_mode_type_ < 3.5) {
+    type = static_cast<int32_t>(std::lround(force_mode_type_));
+  }
+  streamed_registers_.force_mode_type = type;
+}
+
+void URPositionHardwareInterface::postStreamedRegisters()
+{
+  if (!streamed_registers_.resend &&
+      sameValues(streamed_registers_.force_mode_values, streamed_registers_posted_.force_mode_values) &&
+      streamed_registers_.force_mode_selection == streamed_registers_posted_.force_mode_selection &&
+      streamed_registers_.force_mode_type == streamed_registers_posted_.force_mode_type &&
+      streamed_registers_.command_seq == streamed_registers_posted_.command_seq &&
+      sameValues(streamed_registers_.register_values, streamed_registers_posted_.register_values) &&
+      sameValue(streamed_registers_.servoj_gain, streamed_registers_posted_.servoj_gain) &&
+      sameValue(streamed_registers_.servoj_lookahead_time, streamed_registers_posted_.servoj_lookahead_time)) {
+    return;
+  }
+  // With a full mailbox the values are posted again in the next cycle.
+  if (async_mailbox_.postRegisters(streamed_registers_)) {
+    streamed_registers_posted_ = streamed_registers_;
+    streamed_registers_.resend = false;
+  }
+}
+
+void URPositionHardwareInterface::sendStreamedRegisters()
+{
+  // Only the newest values are of interest, older ones are skipped.
+  StreamedRegisters registers;
+  while (async_mailbox_.takeRegisters(registers)) {
+    if (registers.resend) {
+      force_mode_values_sent_.fill(NO_NEW_CMD_);
+      force_mode_selection_sent_ = -1;
+      force_mode_type_sent_ = -1;
+      command_seq_sent_ = 0;
+      register_values_sent_.fill(NO_NEW_CMD_);
+      servoj_gain_sent_ = NO_NEW_CMD_;
+      servoj_lookahead_time_sent_ = NO_NEW_CMD_;
+    }
+    streamed_registers_received_ = registers;
+    streamed_registers_available_ = true;
+  }
+
+  // values that could not be sent are retried in the next pass
+  if (!streamed_registers_available_ || ur_driver_ == nullptr || connection_state_ != ConnectionState::CONNECTED) {
+    return;
+  }
+  if (!register_commands_.empty()) {
+    sendRegisterCommands(streamed_registers_received_);
+  }
+  if (servoj_parameter_register_ >= 0) {
+    sendServojParameters(streamed_registers_received_);
+  }
+  if (force_mode_register_ >= 0) {
+    sendForceMode(streamed_registers_received_);
+  }
+  if (command_tracking_register_ >= 0) {
+    sendCommandSequence(streamed_registers_received_);
+  }
+}
+
+void URPositionHardwareInterface::sendForceMode(const StreamedRegisters& registers)
+{
+  rtde::RTDEWriter& writer = ur_driver_->getRTDEWriter();
+  // The client library sends every register in a package of its own, so only changed values are sent.
+  // Values that were not sent yet are NaN and differ from every command.
+  for (size_t i = 0; i < force_mode_values_sent_.size(); ++i) {
+    const double value = registers.force_mode_values[i];
+    if (value != force_mode_values_sent_[i] &&
+        writer.sendInputDoubleRegister(force_mode_register_ + static_cast<uint32_t>(i), value)) {
+      force_mode_values_sent_[i] = value;
+    }
+  }
+  if (registers.force_mode_selection != force_mode_selection_sent_ &&
+      writer.sendInputIntRegister(force_mode_register_ + 1, registers.force_mode_selection)) {
+    force_mode_selection_sent_ = registers.force_mode_selection;
+  }
+  if (registers.force_mode_type != force_mode_type_sent_ &&
+      writer.sendInputIntRegister(force_mode_register_, registers.force_mode_type)) {
+    force_mode_type_sent_ = registers.force_mode_type;
+  }
+}
+
+void URPositionHardwareInterface::adaptServojLookahead()
+{
+  const auto now = std::chrono::steady_clock::now();
+  const double jitter = stale_cycles_ + static_cast<double>(packet_statistics_.getLatePackets()) +
+                        robot_extrapolated_steps_;
+  if (servoj_adaptation_cycles_ == 0) {
+    servoj_adaptation_start_ = now;
+    servoj_adaptation_jitter_baseline_ = jitter;
+    servoj_adaptation_max_tracking_error_ = 0.0;
+  }
+  ++servoj_adaptation_cycles_;
+
+  // A gap in the history, e.g. after a controller switch, makes the old commands meaningless.
+  if (servoj_command_history_count_ > 0) {
+    const size_t newest =
+        (servoj_command_history_next_ + servoj_command_history_.size() - 1) % servoj_command_history_.size();
+    if (now - servoj_command_history_[newest].time > SERVOJ_COMMAND_HISTORY_GAP) {
+      servoj_command_history_count_ = 0;
+    }
+  }
+  servoj_command_history_[servoj_command_history_next_] = { now, urcl_position_commands_ };
+  servoj_command_history_next_ = (servoj_command_history_next_ + 1) % servoj_command_history_.size();
+  servoj_command_history_count_ = std::min(servoj_command_history_count_ + 1, servoj_command_history_.size());
+
+  // The robot follows the commands with a lag of about the lookahead time, which is no tracking error.
+  // Until the history covers the lookahead time there is nothing to compare with.
+  const auto reference_time = now - std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                        std::chrono::duration<double>(servoj_lookahead_time_));
+  for (size_t age = 0; age < servoj_command_history_count_; ++age) {
+    const CommandSample& sample =
+        servoj_command_history_[(servoj_command_history_next_ + servoj_command_history_.size() - 1 - age) %
+                                servoj_command_history_.size()];
+    if (sample.time <= reference_time) {
+      for (size_t i = 0; i < 6; ++i) {
+        servoj_adaptation_max_tracking_error_ = std::max(servoj_adaptation_max_tracking_error_,
+                                                         std::abs(sample.positions[i] - urcl_joint_positions_[i]));
+      }
+      break;
+    }
+  }
+
+  if (now - servoj_adaptation_start_ < SERVOJ_ADAPTATION_WINDOW) {
+    return;
+  }
+
+  const double jitter_fraction =
+      (jitter - servoj_adaptation_jitter_baseline_) / static_cast<double>(servoj_adaptation_cycles_);
+  const bool tracking_ok = servoj_adaptation_max_tracking_error_ <= servoj_tracking_error_tolerance_;
+  if (jitter_fraction > SERVOJ_ADAPTATION_JITTER_FRACTION && tracking_ok) {
+    servoj_lookahead_time_ = std::min(servoj_lookahead_time_ + SERVOJ_ADAPTATION_STEP, servoj_lookahead_max_);
+  } else if (jitter_fraction == 0.0 || !tracking_ok) {
+    servoj_lookahead_time_ = std::max(servoj_lookahead_time_ - SERVOJ_ADAPTATION_STEP, servoj_lookahead_min_);
+  }
+  servoj_adaptation_cycles_ = 0;
+}
+
+void URPositionHardwareInterface::writeCommandSequence()
+{
+  command_seq_ = command_seq_ == std::numeric_limits<int32_t>::max() ? 1 : command_seq_ + 1;
+  streamed_registers_.command_seq = command_seq_;
+}
+
+void URPositionHardwareInterface::sendCommandSequence(const StreamedRegisters& registers)
+{
+  if (registers.command_seq <= 0 || registers.command_seq == command_seq_sent_) {
+    return;
+  }
+  const auto send_time = std::chrono::steady_clock::now();
+  if (!ur_driver_->getRTDEWriter().sendInputIntRegister(command_tracking_register_, registers.command_seq)) {
+    return;
+  }
+  command_seq_sent_ = registers.command_seq;
+  // A sequence number the control thread does not learn about is never matched, which only costs a
+  // sample.
+  async_mailbox_.postSentSequence({ SentSequence::Type::COMMAND, registers.command_seq, send_time, 0 });
+}
+
+void URPositionHardwareInterface::collectSentSequences()
+{
+  SentSequence sent;
+  while (async_mailbox_.takeSentSequence(sent)) {
+    std::array<SequenceSample, 64>& samples =
+        sent.type == SentSequence::Type::LATENCY_PROBE ? latency_probe_samples_ : command_samples_;
+    SequenceSample& sample = samples[sent.seq % samples.size()];
+    sample.seq = sent.seq;
+    sample.send_time = sent.send_time;
+    sample.write_cycle = sent.write_cycle;
+  }
+}
+
+void URPositionHardwareInterface::readCommandTracking(std::chrono::steady_clock::time_point now)
+{
+  const int32_t executed_seq = command_tracking_outputs_[0];
+  robot_skipped_commands_ = static_cast<double>(command_tracking_outputs_[1]);
+  robot_extrapolated_steps_ = static_cast<double>(command_tracking_outputs_[2]);
+  robot_max_extrapolations_ = static_cast<double>(command_tracking_outputs_[3]);
+  if (executed_seq <= 0) {
+    return;
+  }
+
+  // The age is only known while the command is still in the sample buffer, otherwise it is older
+  // than the buffer is long.
+  const SequenceSample& sample = command_samples_[executed_seq % command_samples_.size()];
+  if (sample.seq == executed_seq) {
+    command_age_cycles_ = static_cast<double>(command_seq_ - executed_seq);
+    command_age_us_ = std::chrono::duration<double, std::micro>(now - sample.send_time).count();
+  } else {
+    command_age_cycles_ = static_cast<double>(command_samples_.size());
+    command_age_us_ = std::numeric_limits<double>::infinity();
+  }
+
+  if (mode_switch_seq_ > 0 && executed_seq >= mode_switch_seq_) {
+    mode_switch_robot_us_ = std::chrono::duration<double, std::micro>(now - mode_switch_time_).count();
+    mode_switch_seq_ = 0;
+  }
+}
+
+void URPositionHardwareInterface::finishModeSwitch()
+{
+  mode_switch_cycles_ = static_cast<double>(mode_switch_write_cycles_);
+  mode_switch_us_ =
+      std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - mode_switch_time_).count();
+  // the sequence number was written right before the command
+  mode_switch_seq_ = command_tracking_register_ >= 0 ? command_seq_ : 0;
+  mode_switch_pending_ = false;
+}
+
+void URPositionHardwareInterface::writeTrajectoryForwarding()
+{
+  if (trajectory_abort_ != 0.0) {
+    trajectory_abort_ = 0.0;
+    trajectory_cancel_ = trajectory_active_;
+  }
+
+  // A point of a new trajectory is only taken over once the previous one finished. The controller
+  // aborts the previous one before it starts a new one.
+  const bool next_point =
+      trajectory_active_ && !trajectory_cancel_ && trajectory_points_sent_ < trajectory_point_count_;
+  if (trajectory_transfer_state_ == TRANSFER_POINT_READY && (!trajectory_active_ || next_point)) {
+    TrajectoryPoint point;
+    if (!trajectory_active_) {
+      point.trajectory_id = trajectory_id_ % MAX_TRAJECTORY_ID + 1;
+      point.index = 1;
+      point.count = static_cast<int32_t>(trajectory_number_of_points_);
+      point.duration = trajectory_time_from_start_;
+    } else {
+      point.trajectory_id = trajectory_id_;
+      point.index = trajectory_points_sent_ + 1;
+      point.count = trajectory_point_count_;
+      point.duration = trajectory_time_from_start_ - trajectory_last_time_from_start_;
+    }
+    point.positions = trajectory_setpoint_positions_;
+    point.velocities = trajectory_setpoint_velocities_;
+
+    // a full queue keeps the point in the interfaces until the next cycle
+    if (point.count > 0 && trajectory_forwarder_.postPoint(point)) {
+      if (!trajectory_active_) {
+        trajectory_id_ = point.trajectory_id;
+        trajectory_point_count_ = point.count;
+        trajectory_points_sent_ = 0;
+        trajectory_points_done_ = 0.0;
+        trajectory_result_ = static_cast<double>(TrajectoryResult::RUNNING);
+        trajectory_active_ = true;
+      }
+      ++trajectory_points_sent_;
+      trajectory_last_time_from_start_ = trajectory_time_from_start_;
+      trajectory_transfer_state_ = TRANSFER_IDLE;
+    } else if (point.count <= 0) {
+      RCLCPP_ERROR(rclcpp::get_logger("URPositionHardwareInterface"), "Rejecting a trajectory without points.");
+      trajectory_result_ = static_cast<double>(TrajectoryResult::FAILURE);
+      trajectory_transfer_state_ = TRANSFER_IDLE;
+    }
+  }
+
+  // The reverse interface keeps the robot program in forwarding mode. The first joint value carries
+  // the id of a trajectory to cancel, 0 if there is none.
+  urcl::vector6d_t forward_command = { { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 } };
+  if (trajectory_cancel_) {
+    forward_command[0] = static_cast<double>(trajectory_id_);
+  }
+  ur_driver_->writeJointCommand(forward_command, urcl::comm::ControlMode::MODE_FORWARD);
+}
+
+void URPositionHardwareInterface::readTrajectoryReports()
+{
+  TrajectoryReport report;
+  while (trajectory_forwarder_.takeReport(report)) {
+    // reports of a canceled trajectory may arrive after the next one started
+    if (!trajectory_active_ || report.trajectory_id != trajectory_id_) {
+      continue;
+    }
+    trajectory_points_done_ = static_cast<double>(report.points_done);
+    if (report.result != TrajectoryResult::RUNNING) {
+      finishTrajectory(report.result);
+    }
+  }
+
+  if (trajectory_active_ && !trajectory_forwarder_.isConnected()) {
+    RCLCPP_ERROR(rclcpp::get_logger("URPositionHardwareInterface"),
+                 "Robot program is not connected to the trajectory socket, aborting the trajectory.");
+    finishTrajectory(TrajectoryResult::FAILURE);
+  }
+}
+
+void URPositionHardwareInterface::finishTrajectory(TrajectoryResult result)
+{
+  trajectory_result_ = static_cast<double>(result);
+  trajectory_active_ = false;
+  trajectory_cancel_ = false;
+}
+
+void URPositionHardwareInterface::resetStaleCommands()
+{
+  urcl_position_commands_old_ = urcl_position_commands_;
+  urcl_velocity_commands_old_ = urcl_velocity_commands_;
+  urcl_twist_commands_old_ = urcl_twist_commands_;
+  position_command_step_ = { { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 } };
+  stale_cycles_since_write_ = 0;
+}
+
+void URPositionHardwareInterface::writeStaleCommands()
+{
+  // The robot consumes one command per control step. Sending more often than that would queue
+  // commands in the socket and delay all following ones.
+  const double control_step = packet_statistics_.getControlStep();
+  if (control_step > 0.0 && std::chrono::steady_clock::now() - last_command_write_time_ <
+                                std::chrono::duration<double>(0.9 * control_step)) {
+    return;
+  }
+
+  if (position_controller_running_) {
+    if (extrapolate_stale_commands_) {
+      for (size_t i = 0; i < 6; ++i) {
+        urcl_position_commands_old_[i] += position_command_step_[i];
+      }
+    }
+    ur_driver_->writeJointCommand(urcl_position_commands_old_, urcl::comm::ControlMode::MODE_SERVOJ);
+  } else if (velocity_controller_running_) {
+    ur_driver_->writeJointCommand(urcl_velocity_commands_old_, urcl::comm::ControlMode::MODE_SPEEDJ);
+  } else if (twist_controller_running_) {
+    ur_driver_->writeJointCommand(urcl_twist_commands_old_, urcl::comm::ControlMode::MODE_SPEEDL);
+  } else {
+    ur_driver_->writeKeepalive();
+  }
+
+  if (mode_switch_pending_) {
+    finishModeSwitch();
+  }
+  ++stale_cycles_since_write_;
+  last_command_write_time_ = std::chrono::steady_clock::now();
+}
+
 void URPositionHardwareInterface::handleRobotProgramState(bool program_running)
 {
   robot_program_running_ = program_running;
@@ -574,128 +2567,315 @@ void URPositionHardwareInterface::initAsyncIO()
   payload_center_of_gravity_ = { NO_NEW_CMD_, NO_NEW_CMD_, NO_NEW_CMD_ };
 }
 
-void URPositionHardwareInterface::checkAsyncIO()
+void URPositionHardwareInterface::dispatchAsyncCommands()
 {
+  // All output changes of a cycle are merged into a single command. A command stays in its interfaces
+  // if the mailbox is full and is dispatched in a later cycle.
+  AsyncCommand outputs{
+    AsyncCommand::Type::SET_OUTPUTS, 0, 0, { NO_NEW_CMD_, NO_NEW_CMD_, NO_NEW_CMD_, NO_NEW_CMD_ }, 0
+  };
   for (size_t i = 0; i < 18; ++i) {
-    if (!std::isnan(standard_dig_out_bits_cmd_[i]) && ur_driver_ != nullptr) {
-      if (i <= 7) {
-        io_async_success_ =
-            ur_driver_->getRTDEWriter().sendStandardDigitalOutput(i, static_cast<bool>(standard_dig_out_bits_cmd_[i]));
-      } else if (i <= 15) {
-        io_async_success_ = ur_driver_->getRTDEWriter().sendConfigurableDigitalOutput(
-            static_cast<uint8_t>(i - 8), static_cast<bool>(standard_dig_out_bits_cmd_[i]));
-      } else {
-        io_async_success_ = ur_driver_->getRTDEWriter().sendToolDigitalOutput(
-            static_cast<uint8_t>(i - 16), static_cast<bool>(standard_dig_out_bits_cmd_[i]));
+    if (!std::isnan(standard_dig_out_bits_cmd_[i])) {
+      outputs.digital_output_mask |= 1u << i;
+      if (static_cast<bool>(standard_dig_out_bits_cmd_[i])) {
+        outputs.digital_output_bits |= 1u << i;
       }
-      standard_dig_out_bits_cmd_[i] = NO_NEW_CMD_;
     }
   }
-
+  bool analog_outputs_changed = false;
   for (size_t i = 0; i < 2; ++i) {
-    if (!std::isnan(standard_analog_output_cmd_[i]) && ur_driver_ != nullptr) {
-      io_async_success_ = ur_driver_->getRTDEWriter().sendStandardAnalogOutput(i, standard_analog_output_cmd_[i]);
-      standard_analog_output_cmd_[i] = NO_NEW_CMD_;
-    }
+    outputs.values[i] = standard_analog_output_cmd_[i];
+    analog_outputs_changed |= !std::isnan(standard_analog_output_cmd_[i]);
+  }
+  if ((outputs.digital_output_mask != 0 || analog_outputs_changed) && async_mailbox_.postCommand(outputs)) {
+    standard_dig_out_bits_cmd_.fill(NO_NEW_CMD_);
+    standard_analog_output_cmd_.fill(NO_NEW_CMD_);
   }
 
-  if (!std::isnan(target_speed_fraction_cmd_) && ur_driver_ != nullptr) {
-    scaling_async_success_ = ur_driver_->getRTDEWriter().sendSpeedSlider(target_speed_fraction_cmd_);
+  if (!std::isnan(target_speed_fraction_cmd_) &&
+      async_mailbox_.postCommand(
+          { AsyncCommand::Type::SPEED_SLIDER, 0, 0, { target_speed_fraction_cmd_, 0.0, 0.0, 0.0 }, 0 })) {
     target_speed_fraction_cmd_ = NO_NEW_CMD_;
   }
 
-  if (!std::isnan(resend_robot_program_cmd_) && ur_driver_ != nullptr) {
-    try {
-      resend_robot_program_async_success_ = ur_driver_->sendRobotProgram();
-    } catch (const urcl::UrException& e) {
-      RCLCPP_ERROR(rclcpp::get_logger("URPositionHardwareInterface"), "Service Call failed: '%s'", e.what());
-    }
+  if (!std::isnan(resend_robot_program_cmd_) &&
+      async_mailbox_.postCommand({ AsyncCommand::Type::RESEND_ROBOT_PROGRAM, 0, 0, { 0.0, 0.0, 0.0, 0.0 }, 0 })) {
     resend_robot_program_cmd_ = NO_NEW_CMD_;
   }
 
   if (!std::isnan(payload_mass_) && !std::isnan(payload_center_of_gravity_[0]) &&
-      !std::isnan(payload_center_of_gravity_[1]) && !std::isnan(payload_center_of_gravity_[2]) &&
-      ur_driver_ != nullptr) {
-    try {
-      // create command as string from interfaces
-      // ROS1 driver hardware_interface.cpp#L450-L456
-      std::stringstream str_command;
-      str_command.imbue(std::locale::classic());
-      str_command << "sec setup():" << std::endl
-                  << " set_payload(" << payload_mass_ << ", [" << payload_center_of_gravity_[0] << ", "
-                  << payload_center_of_gravity_[1] << ", " << payload_center_of_gravity_[2] << "])" << std::endl
-                  << "end";
-      payload_async_success_ = ur_driver_->sendScript(str_command.str());
-    } catch (const urcl::UrException& e) {
-      RCLCPP_ERROR(rclcpp::get_logger("URPositionHardwareInterface"), "Service Call failed: '%s'", e.what());
-    }
-    payload_mass_ = NO_NEW_CMD_;
-    payload_center_of_gravity_ = { NO_NEW_CMD_, NO_NEW_CMD_, NO_NEW_CMD_ };
+      !std::isnan(payload_center_of_gravity_[1]) && !std::isnan(payload_center_of_gravity_[2])) {
+    if (payload_register_ >= 0 && robot_program_running_) {
+      // The async thread writes the registers, the robot program applies the payload and confirms it
+      // in read(). A new payload waits until the previous one is confirmed.
+      const int32_t seq = payload_seq_ == std::numeric_limits<int32_t>::max() ? 1 : payload_seq_ + 1;
+      if (!payload_pending_ && connection_state_ == ConnectionState::CONNECTED &&
+          async_mailbox_.postCommand({ AsyncCommand::Type::SET_PAYLOAD_REGISTERS,
+                                       0,
+                                       0,
+                                       { payload_mass_, payload_center_of_gravity_[0], payload_center_of_gravity_[1],
+                                         payload_center_of_gravity_[2] },
+                                       seq })) {
+        payload_seq_ = seq;
+        payload_send_time_ = std::chrono::steady_clock::now();
+        payload_pending_ = true;
+        payload_mass_ = NO_NEW_CMD_;
+        payload_center_of_gravity_ = { NO_NEW_CMD_, NO_NEW_CMD_, NO_NEW_CMD_ };
+      }
+    } else if (async_mailbox_.postCommand({ AsyncCommand::Type::SET_PAYLOAD,
+                                            0,
+                                            0,
+                                            { payload_mass_, payload_center_of_gravity_[0],
+                                              payload_center_of_gravity_[1], payload_center_of_gravity_[2] },
+                                            0 })) {
+      payload_mass_ = NO_NEW_CMD_;
+      payload_center_of_gravity_ = { NO_NEW_CMD_, NO_NEW_CMD_, NO_NEW_CMD_ };
+    }
   }
 }
 
-void URPositionHardwareInterface::updateNonDoubleValues()
+bool URPositionHardwareInterface::writePayload(const AsyncCommand& command)
 {
-  for (size_t i = 0; i < 18; ++i) {
-    actual_dig_out_bits_copy_[i] = static_cast<double>(actual_dig_out_bits_[i]);
-    actual_dig_in_bits_copy_[i] = static_cast<double>(actual_dig_in_bits_[i]);
+  rtde::RTDEWriter& writer = ur_driver_->getRTDEWriter();
+  // The client library sends every register in a package of its own. The sequence number goes last,
+  // so the robot program never sees it before the values.
+  bool sent = true;
+  for (size_t i = 0; i < 4; ++i) {
+    sent &= writer.sendInputDoubleRegister(payload_register_ + i, command.values[i]);
   }
+  return sent && writer.sendInputIntRegister(payload_register_, command.seq);
+}
 
-  for (size_t i = 0; i < 11; ++i) {
-    safety_status_bits_copy_[i] = static_cast<double>(safety_status_bits_[i]);
+void URPositionHardwareInterface::readPayloadConfirmation(std::chrono::steady_clock::time_point now)
+{
+  if (payload_echo_ == payload_seq_) {
+    payload_applied_latency_us_ = std::chrono::duration<double, std::micro>(now - payload_send_time_).count();
+    payload_async_success_ = 1.0;
+    payload_pending_ = false;
+  } else if (now - payload_send_time_ > PAYLOAD_CONFIRMATION_TIMEOUT) {
+    payload_async_success_ = 0.0;
+    payload_pending_ = false;
   }
+}
 
-  for (size_t i = 0; i < 4; ++i) {
-    analog_io_types_copy_[i] = static_cast<double>(analog_io_types_[i]);
-    robot_status_bits_copy_[i] = static_cast<double>(robot_status_bits_[i]);
+void URPositionHardwareInterface::collectAsyncResults()
+{
+  AsyncCommandResult result;
+  while (async_mailbox_.takeResult(result)) {
+    const double success = result.success ? 1.0 : 0.0;
+    switch (result.type) {
+      case AsyncCommand::Type::SET_OUTPUTS:
+        io_async_success_ = success;
+        break;
+      case AsyncCommand::Type::SPEED_SLIDER:
+        scaling_async_success_ = success;
+        break;
+      case AsyncCommand::Type::RESEND_ROBOT_PROGRAM:
+        resend_robot_program_async_success_ = success;
+        break;
+      case AsyncCommand::Type::SET_PAYLOAD:
+        payload_async_success_ = success;
+        break;
+      case AsyncCommand::Type::SET_PAYLOAD_REGISTERS:
+        // success is only reported once the robot program echoed the sequence number
+        if (!result.success) {
+          payload_async_success_ = 0.0;
+          payload_pending_ = false;
+        }
+        break;
+    }
   }
+}
 
-  for (size_t i = 0; i < 2; ++i) {
-    tool_analog_input_types_copy_[i] = static_cast<double>(tool_analog_input_types_[i]);
+void URPositionHardwareInterface::processAsyncCommands()
+{
+  // Output changes of several cycles are merged as well, so each output is written at most once.
+  AsyncCommand outputs{
+    AsyncCommand::Type::SET_OUTPUTS, 0, 0, { NO_NEW_CMD_, NO_NEW_CMD_, NO_NEW_CMD_, NO_NEW_CMD_ }, 0
+  };
+  size_t merged_outputs = 0;
+
+  AsyncCommand command;
+  while (async_mailbox_.takeCommand(command)) {
+    if (command.type == AsyncCommand::Type::SET_OUTPUTS) {
+      outputs.digital_output_mask |= command.digital_output_mask;
+      outputs.digital_output_bits =
+          (outputs.digital_output_bits & ~command.digital_output_mask) | command.digital_output_bits;
+      for (size_t i = 0; i < 2; ++i) {
+        if (!std::isnan(command.values[i])) {
+          outputs.values[i] = command.values[i];
+        }
+      }
+      ++merged_outputs;
+      continue;
+    }
+    postAsyncResult(command.type, executeAsyncCommand(command));
   }
 
-  tool_output_voltage_copy_ = static_cast<double>(tool_output_voltage_);
-  robot_mode_copy_ = static_cast<double>(robot_mode_);
-  safety_mode_copy_ = static_cast<double>(safety_mode_);
-  tool_mode_copy_ = static_cast<double>(tool_mode_);
-  system_interface_initialized_ = initialized_ ? 1.0 : 0.0;
+  if (merged_outputs > 0) {
+    const bool success = executeAsyncCommand(outputs);
+    // every request waits for a result of its own
+    for (size_t i = 0; i < merged_outputs; ++i) {
+      postAsyncResult(AsyncCommand::Type::SET_OUTPUTS, success);
+    }
+  }
 }
 
-void URPositionHardwareInterface::transformForceTorque()
+void URPositionHardwareInterface::postAsyncResult(AsyncCommand::Type type, bool success)
 {
-  // imported from ROS1 driver - hardware_interface.cpp#L867-L876
-  tcp_force_.setValue(urcl_ft_sensor_measurements_[0], urcl_ft_sensor_measurements_[1],
-                      urcl_ft_sensor_measurements_[2]);
-  tcp_torque_.setValue(urcl_ft_sensor_measurements_[3], urcl_ft_sensor_measurements_[4],
-                       urcl_ft_sensor_measurements_[5]);
+  // The control thread collects results every cycle, so the queue only fills up if it is stuck.
+  if (!async_mailbox_.postResult({ type, success })) {
+    RCLCPP_WARN(rclcpp::get_logger("URPositionHardwareInterface"), "Dropping result of an asynchronous command.");
+  }
+}
 
-  tf2::Quaternion rotation_quat;
-  tf2::fromMsg(tcp_transform_.transform.rotation, rotation_quat);
-  tcp_force_ = tf2::quatRotate(rotation_quat.inverse(), tcp_force_);
-  tcp_torque_ = tf2::quatRotate(rotation_quat.inverse(), tcp_torque_);
+bool URPositionHardwareInterface::executeAsyncCommand(const AsyncCommand& command)
+{
+  if (ur_driver_ == nullptr) {
+    return false;
+  }
 
-  urcl_ft_sensor_measurements_ = { tcp_force_.x(),  tcp_force_.y(),  tcp_force_.z(),
-                                   tcp_torque_.x(), tcp_torque_.y(), tcp_torque_.z() };
+  switch (command.type) {
+    case AsyncCommand::Type::SET_OUTPUTS:
+      return writeOutputs(command);
+    case AsyncCommand::Type::SPEED_SLIDER:
+      return ur_driver_->getRTDEWriter().sendSpeedSlider(command.values[0]);
+    case AsyncCommand::Type::RESEND_ROBOT_PROGRAM:
+      try {
+        return ur_driver_->sendRobotProgram();
+      } catch (const urcl::UrException& e) {
+        RCLCPP_ERROR(rclcpp::get_logger("URPositionHardwareInterface"), "Service Call failed: '%s'", e.what());
+      }
+      return false;
+    case AsyncCommand::Type::SET_PAYLOAD:
+      try {
+        // create command as string from interfaces
+        // ROS1 driver hardware_interface.cpp#L450-L456
+        std::stringstream str_command;
+        str_command.imbue(std::locale::classic());
+        str_command << "sec setup():" << std::endl
+                    << " set_payload(" << command.values[0] << ", [" << command.values[1] << ", " << command.values[2]
+                    << ", " << command.values[3] << "])" << std::endl
+                    << "end";
+        return ur_driver_->sendScript(str_command.str());
+      } catch (const urcl::UrException& e) {
+        RCLCPP_ERROR(rclcpp::get_logger("URPositionHardwareInterface"), "Service Call failed: '%s'", e.what());
+      }
+      return false;
+    case AsyncCommand::Type::SET_PAYLOAD_REGISTERS:
+      return writePayload(command);
+  }
+  return false;
+}
+
+bool URPositionHardwareInterface::writeOutputs(const AsyncCommand& command)
+{
+  // The client library's writer has a setter per output, each of them sending a package of its own.
+  // The masks in the input recipe only ever cover a single output that way, so the writes are issued
+  // back to back.
+  rtde::RTDEWriter& writer = ur_driver_->getRTDEWriter();
+  bool success = true;
+  for (uint8_t i = 0; i < 18; ++i) {
+    if (!(command.digital_output_mask & (1u << i))) {
+      continue;
+    }
+    const bool value = command.digital_output_bits & (1u << i);
+    if (i <= 7) {
+      success &= writer.sendStandardDigitalOutput(i, value);
+    } else if (i <= 15) {
+      success &= writer.sendConfigurableDigitalOutput(static_cast<uint8_t>(i - 8), value);
+    } else {
+      success &= writer.sendToolDigitalOutput(static_cast<uint8_t>(i - 16), value);
+    }
+  }
+  for (uint8_t i = 0; i < 2; ++i) {
+    if (!std::isnan(command.values[i])) {
+      success &= writer.sendStandardAnalogOutput(i, command.values[i]);
+    }
+  }
+  return success;
 }
 
-void URPositionHardwareInterface::extractToolPose()
+void URPositionHardwareInterface::updateNonDoubleValues()
 {
-  // imported from ROS1 driver hardware_interface.cpp#L911-L928
-  double tcp_angle =
-      std::sqrt(std::pow(urcl_tcp_pose_[3], 2) + std::pow(urcl_tcp_pose_[4], 2) + std::pow(urcl_tcp_pose_[5], 2));
+  // The raw values hardly ever change, so they are only converted if they differ from the last cycle.
+  const bool force = !non_double_values_converted_;
+  bool changed = false;
 
-  tf2::Vector3 rotation_vec(urcl_tcp_pose_[3], urcl_tcp_pose_[4], urcl_tcp_pose_[5]);
-  tf2::Quaternion rotation;
-  if (tcp_angle > 1e-16) {
-    rotation.setRotation(rotation_vec.normalized(), tcp_angle);
-  } else {
-    rotation.setValue(0.0, 0.0, 0.0, 1.0);  // default Quaternion is 0,0,0,0 which is invalid
+  if (valueChanged(actual_dig_out_bits_, last_actual_dig_out_bits_, force)) {
+    for (size_t i = 0; i < 18; ++i) {
+      actual_dig_out_bits_copy_[i] = static_cast<double>((actual_dig_out_bits_ >> i) & 1u);
+    }
+    changed = true;
+  }
+
+  if (valueChanged(actual_dig_in_bits_, last_actual_dig_in_bits_, force)) {
+    for (size_t i = 0; i < 18; ++i) {
+      actual_dig_in_bits_copy_[i] = static_cast<double>((actual_dig_in_bits_ >> i) & 1u);
+    }
+    changed = true;
+  }
+
+  if (valueChanged(safety_status_bits_, last_safety_status_bits_, force)) {
+    for (size_t i = 0; i < 11; ++i) {
+      safety_status_bits_copy_[i] = static_cast<double>((safety_status_bits_ >> i) & 1u);
+    }
+    changed = true;
+  }
+
+  if (valueChanged(analog_io_types_, last_analog_io_types_, force)) {
+    for (size_t i = 0; i < 4; ++i) {
+      analog_io_types_copy_[i] = static_cast<double>((analog_io_types_ >> i) & 1u);
+    }
+    changed = true;
+  }
+
+  if (valueChanged(robot_status_bits_, last_robot_status_bits_, force)) {
+    for (size_t i = 0; i < 4; ++i) {
+      robot_status_bits_copy_[i] = static_cast<double>((robot_status_bits_ >> i) & 1u);
+    }
+    changed = true;
+  }
+
+  if (valueChanged(tool_analog_input_types_, last_tool_analog_input_types_, force)) {
+    for (size_t i = 0; i < 2; ++i) {
+      tool_analog_input_types_copy_[i] = static_cast<double>((tool_analog_input_types_ >> i) & 1u);
+    }
+    changed = true;
+  }
+
+  if (valueChanged(tool_output_voltage_, last_tool_output_voltage_, force)) {
+    tool_output_voltage_copy_ = static_cast<double>(tool_output_voltage_);
+    changed = true;
+  }
+
+  if (valueChanged(robot_mode_, last_robot_mode_, force)) {
+    robot_mode_copy_ = static_cast<double>(robot_mode_);
+    changed = true;
+  }
+
+  if (valueChanged(safety_mode_, last_safety_mode_, force)) {
+    safety_mode_copy_ = static_cast<double>(safety_mode_);
+    changed = true;
+  }
+
+  if (valueChanged(tool_mode_, last_tool_mode_, force)) {
+    tool_mode_copy_ = static_cast<double>(tool_mode_);
+    changed = true;
   }
-  tcp_transform_.transform.translation.x = urcl_tcp_pose_[0];
-  tcp_transform_.transform.translation.y = urcl_tcp_pose_[1];
-  tcp_transform_.transform.translation.z = urcl_tcp_pose_[2];
 
-  tcp_transform_.transform.rotation = tf2::toMsg(rotation);
+  if (changed) {
+    gpio_change_seq_ += 1.0;
+  }
+  non_double_values_converted_ = true;
+
+  system_interface_initialized_ = initialized_ ? 1.0 : 0.0;
+  rtde_package_allocations_ = static_cast<double>(package_recycler_.getControlThreadAllocations());
+  rtde_received_packets_ = static_cast<double>(packet_statistics_.getReceivedPackets());
+  rtde_missed_packets_ = static_cast<double>(packet_statistics_.getMissedPackets());
+  rtde_late_packets_ = static_cast<double>(packet_statistics_.getLatePackets());
+  rtde_duplicate_packets_ = static_cast<double>(packet_statistics_.getDuplicatePackets());
+  rtde_max_gap_ = packet_statistics_.getMaxGap();
 }
 
 hardware_interface::return_type URPositionHardwareInterface::prepare_command_mode_switch(
@@ -705,6 +2885,12 @@ hardware_interface::return_type URPositionHardwareInterface::prepare_command_mod
 
   start_modes_.clear();
   stop_modes_.clear();
+  start_twist_control_ = false;
+  stop_twist_control_ = false;
+  start_force_mode_ = false;
+  stop_force_mode_ = false;
+  start_trajectory_forwarding_ = false;
+  stop_trajectory_forwarding_ = false;
 
   // Starting interfaces
   // add start interface per joint in tmp var for later check
@@ -728,6 +2914,36 @@ hardware_interface::return_type URPositionHardwareInterface::prepare_command_mod
     ret_val = hardware_interface::return_type::ERROR;
   }
 
+  // forwarded trajectories can't be mixed with joint commands either
+  for (const auto& key : start_interfaces) {
+    if (key.rfind("trajectory_forwarding/", 0) == 0) {
+      start_trajectory_forwarding_ = true;
+    }
+  }
+  if (start_trajectory_forwarding_ && start_modes_.size() != 0) {
+    ret_val = hardware_interface::return_type::ERROR;
+  }
+
+  // the TCP velocity is claimed as a whole and excludes all other modes
+  size_t start_twist_interfaces = 0;
+  for (const auto& key : start_interfaces) {
+    if (key.rfind("tcp_twist/", 0) == 0) {
+      ++start_twist_interfaces;
+    }
+  }
+  start_twist_control_ = start_twist_interfaces != 0;
+  if (start_twist_control_ &&
+      (start_twist_interfaces != 6 || start_modes_.size() != 0 || start_trajectory_forwarding_)) {
+    ret_val = hardware_interface::return_type::ERROR;
+  }
+
+  // force mode acts on top of the motion commands, so it can run together with any mode
+  for (const auto& key : start_interfaces) {
+    if (key.rfind("force_mode/", 0) == 0) {
+      start_force_mode_ = true;
+    }
+  }
+
   // Stopping interfaces
   // add stop interface per joint in tmp var for later check
   for (const auto& key : stop_interfaces) {
@@ -746,6 +2962,18 @@ hardware_interface::return_type URPositionHardwareInterface::prepare_command_mod
     ret_val = hardware_interface::return_type::ERROR;
   }
 
+  for (const auto& key : stop_interfaces) {
+    if (key.rfind("trajectory_forwarding/", 0) == 0) {
+      stop_trajectory_forwarding_ = true;
+    }
+    if (key.rfind("tcp_twist/", 0) == 0) {
+      stop_twist_control_ = true;
+    }
+    if (key.rfind("force_mode/", 0) == 0) {
+      stop_force_mode_ = true;
+    }
+  }
+
   controllers_initialized_ = true;
   return ret_val;
 }
@@ -755,31 +2983,100 @@ hardware_interface::return_type URPositionHardwareInterface::perform_command_mod
 {
   hardware_interface::return_type ret_val = hardware_interface::return_type::OK;
 
+  // A mode started while the arm is commanded continues from its current motion instead of stopping it
+  const bool handover = position_controller_running_ || velocity_controller_running_ || twist_controller_running_;
+  if (start_modes_.size() != 0 || start_twist_control_ || start_trajectory_forwarding_) {
+    mode_switch_pending_ = true;
+    mode_switch_time_ = std::chrono::steady_clock::now();
+    mode_switch_write_cycles_ = 0;
+    mode_switch_seq_ = 0;
+  }
+
   if (stop_modes_.size() != 0 &&
       std::find(stop_modes_.begin(), stop_modes_.end(), StoppingInterface::STOP_POSITION) != stop_modes_.end()) {
     position_controller_running_ = false;
     urcl_position_commands_ = urcl_position_commands_old_ = urcl_joint_positions_;
+    resetStaleCommands();
   } else if (stop_modes_.size() != 0 &&
              std::find(stop_modes_.begin(), stop_modes_.end(), StoppingInterface::STOP_VELOCITY) != stop_modes_.end()) {
     velocity_controller_running_ = false;
     urcl_velocity_commands_ = { { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 } };
   }
 
+  if (stop_twist_control_) {
+    twist_controller_running_ = false;
+    urcl_twist_commands_ = { { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 } };
+  }
+
+  if (stop_force_mode_) {
+    force_mode_running_ = false;
+  }
+
+  if (stop_trajectory_forwarding_) {
+    trajectory_forwarding_running_ = false;
+    // the robot stops a trajectory nobody supervises any more
+    trajectory_cancel_ = trajectory_active_;
+  }
+
   if (start_modes_.size() != 0 &&
       std::find(start_modes_.begin(), start_modes_.end(), hardware_interface::HW_IF_POSITION) != start_modes_.end()) {
     velocity_controller_running_ = false;
+    twist_controller_running_ = false;
+    trajectory_forwarding_running_ = false;
     urcl_position_commands_ = urcl_position_commands_old_ = urcl_joint_positions_;
+    resetStaleCommands();
+    servoj_adaptation_cycles_ = 0;
+    servoj_command_history_count_ = 0;
     position_controller_running_ = true;
 
   } else if (start_modes_.size() != 0 && std::find(start_modes_.begin(), start_modes_.end(),
                                                    hardware_interface::HW_IF_VELOCITY) != start_modes_.end()) {
     position_controller_running_ = false;
-    urcl_velocity_commands_ = { { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 } };
+    twist_controller_running_ = false;
+    trajectory_forwarding_running_ = false;
+    if (handover) {
+      urcl_velocity_commands_ = urcl_joint_velocities_;
+    } else {
+      urcl_velocity_commands_ = { { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 } };
+    }
+    resetStaleCommands();
     velocity_controller_running_ = true;
+
+  } else if (start_twist_control_) {
+    position_controller_running_ = false;
+    velocity_controller_running_ = false;
+    trajectory_forwarding_running_ = false;
+    urcl_twist_commands_ = { { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 } };
+    resetStaleCommands();
+    twist_controller_running_ = true;
+
+  } else if (start_trajectory_forwarding_) {
+    position_controller_running_ = false;
+    velocity_controller_running_ = false;
+    twist_controller_running_ = false;
+    trajectory_transfer_state_ = TRANSFER_IDLE;
+    trajectory_abort_ = 0.0;
+    resetStaleCommands();
+    trajectory_forwarding_running_ = true;
+  }
+
+  if (start_force_mode_) {
+    // a new controller starts without compliant axes, until it commands its own parameters
+    force_mode_selection_ = { { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 } };
+    force_mode_wrench_ = { { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 } };
+    force_mode_limits_ = FORCE_MODE_DEFAULT_LIMITS;
+    force_mode_type_ = FORCE_MODE_DEFAULT_TYPE;
+    force_mode_running_ = true;
   }
 
   start_modes_.clear();
   stop_modes_.clear();
+  start_twist_control_ = false;
+  stop_twist_control_ = false;
+  start_force_mode_ = false;
+  stop_force_mode_ = false;
+  start_trajectory_forwarding_ = false;
+  stop_trajectory_forwarding_ = false;
 
   return ret_val;
 }
@@ -0,0 +1,378 @@
+// Copyright 2026 FZI Forschungszentrum Informatik
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ur_robot_driver/rtde_output_binding.hpp"
+
+namespace rtde = urcl::rtde_interface;
+
+namespace ur_robot_driver
+{
+namespace
+{
+// Output fields as listed in the RTDE guide. Registers are handled separately as they come in
+// numbered ranges.
+const std::unordered_map<std::string, RTDEFieldType> OUTPUT_FIELD_TYPES = {
+  { "timestamp", RTDEFieldType::DOUBLE },
+  { "target_q", RTDEFieldType::VECTOR6D },
+  { "target_qd", RTDEFieldType::VECTOR6D },
+  { "target_qdd", RTDEFieldType::VECTOR6D },
+  { "target_current", RTDEFieldType::VECTOR6D },
+  { "target_moment", RTDEFieldType::VECTOR6D },
+  { "actual_q", RTDEFieldType::VECTOR6D },
+  { "actual_qd", RTDEFieldType::VECTOR6D },
+  { "actual_current", RTDEFieldType::VECTOR6D },
+  { "joint_control_output", RTDEFieldType::VECTOR6D },
+  { "actual_TCP_pose", RTDEFieldType::VECTOR6D },
+  { "actual_TCP_speed", RTDEFieldType::VECTOR6D },
+  { "actual_TCP_force", RTDEFieldType::VECTOR6D },
+  { "target_TCP_pose", RTDEFieldType::VECTOR6D },
+  { "target_TCP_speed", RTDEFieldType::VECTOR6D },
+  { "actual_digital_input_bits", RTDEFieldType::UINT64 },
+  { "joint_temperatures", RTDEFieldType::VECTOR6D },
+  { "actual_execution_time", RTDEFieldType::DOUBLE },
+  { "robot_mode", RTDEFieldType::INT32 },
+  { "joint_mode", RTDEFieldType::VECTOR6INT32 },
+  { "safety_mode", RTDEFieldType::INT32 },
+  { "safety_status", RTDEFieldType::INT32 },
+  { "actual_tool_accelerometer", RTDEFieldType::VECTOR3D },
+  { "speed_scaling", RTDEFieldType::DOUBLE },
+  { "target_speed_fraction", RTDEFieldType::DOUBLE },
+  { "actual_momentum", RTDEFieldType::DOUBLE },
+  { "actual_main_voltage", RTDEFieldType::DOUBLE },
+  { "actual_robot_voltage", RTDEFieldType::DOUBLE },
+  { "actual_robot_current", RTDEFieldType::DOUBLE },
+  { "actual_joint_voltage", RTDEFieldType::VECTOR6D },
+  { "actual_digital_output_bits", RTDEFieldType::UINT64 },
+  { "runtime_state", RTDEFieldType::UINT32 },
+  { "elbow_position", RTDEFieldType::VECTOR3D },
+  { "elbow_velocity", RTDEFieldType::VECTOR3D },
+  { "robot_status_bits", RTDEFieldType::UINT32 },
+  { "safety_status_bits", RTDEFieldType::UINT32 },
+  { "analog_io_types", RTDEFieldType::UINT32 },
+  { "standard_analog_input0", RTDEFieldType::DOUBLE },
+  { "standard_analog_input1", RTDEFieldType::DOUBLE },
+  { "standard_analog_output0", RTDEFieldType::DOUBLE },
+  { "standard_analog_output1", RTDEFieldType::DOUBLE },
+  { "io_current", RTDEFieldType::DOUBLE },
+  { "euromap67_input_bits", RTDEFieldType::UINT32 },
+  { "euromap67_output_bits", RTDEFieldType::UINT32 },
+  { "euromap67_24V_voltage", RTDEFieldType::DOUBLE },
+  { "euromap67_24V_current", RTDEFieldType::DOUBLE },
+  { "tool_mode", RTDEFieldType::UINT32 },
+  { "tool_analog_input_types", RTDEFieldType::UINT32 },
+  { "tool_analog_input0", RTDEFieldType::DOUBLE },
+  { "tool_analog_input1", RTDEFieldType::DOUBLE },
+  { "tool_output_voltage", RTDEFieldType::INT32 },
+  { "tool_output_current", RTDEFieldType::DOUBLE },
+  { "tool_temperature", RTDEFieldType::DOUBLE },
+  { "tcp_force_scalar", RTDEFieldType::DOUBLE },
+  { "output_bit_registers0_to_31", RTDEFieldType::UINT32 },
+  { "output_bit_registers32_to_63", RTDEFieldType::UINT32 },
+  { "input_bit_registers0_to_31", RTDEFieldType::UINT32 },
+  { "input_bit_registers32_to_63", RTDEFieldType::UINT32 },
+  { "tool_output_mode", RTDEFieldType::UINT8 },
+  { "tool_digital_output0_mode", RTDEFieldType::UINT8 },
+  { "tool_digital_output1_mode", RTDEFieldType::UINT8 },
+  { "payload", RTDEFieldType::DOUBLE },
+  { "payload_cog", RTDEFieldType::VECTOR3D },
+  { "payload_inertia", RTDEFieldType::VECTOR6D },
+  { "script_control_line", RTDEFieldType::UINT32 },
+  { "ft_raw_wrench", RTDEFieldType::VECTOR6D },
+};
+
+// Returns true if name is <prefix><index> with first <= index <= last
+bool matchesRegister(const std::string& name, const std::string& prefix, int first, int last)
+{
+  if (name.compare(0, prefix.size(), prefix) != 0 || name.size() == prefix.size()) {
+    return false;
+  }
+  const std::string index = name.substr(prefix.size());
+  if (index.find_first_not_of("0123456789") != std::string::npos) {
+    return false;
+  }
+  const int register_index = std::stoi(index);
+  return register_index >= first && register_index <= last;
+}
+}  // namespace
+
+std::vector<std::string> RTDEOutputBinding::readRecipe(const std::string& recipe_file)
+{
+  std::ifstream file(recipe_file);
+  if (!file.is_open()) {
+    throw std::runtime_error("Could not open RTDE recipe file '" + recipe_file + "'");
+  }
+
+  std::vector<std::string> recipe;
+  std::string line;
+  while (std::getline(file, line)) {
+    line.erase(0, line.find_first_not_of(" \t\r"));
+    line.erase(line.find_last_not_of(" \t\r") + 1);
+    if (!line.empty()) {
+      recipe.push_back(line);
+    }
+  }
+  return recipe;
+}
+
+bool RTDEOutputBinding::lookupFieldType(const std::string& name, RTDEFieldType& type)
+{
+  auto it = OUTPUT_FIELD_TYPES.find(name);
+  if (it != OUTPUT_FIELD_TYPES.end()) {
+    type = it->second;
+    return true;
+  }
+
+  // The lower half of the input int and double registers is reserved for fieldbus adapters, RTDE
+  // clients may only write the upper half.
+  for (const std::string direction : { "output", "input" }) {
+    const int first_word_register = direction == "input" ? 24 : 0;
+    if (matchesRegister(name, direction + "_bit_register_", 64, 127)) {
+      type = RTDEFieldType::BOOL;
+      return true;
+    }
+    if (matchesRegister(name, direction + "_int_register_", first_word_register, 47)) {
+      type = RTDEFieldType::INT32;
+      return true;
+    }
+    if (matchesRegister(name, direction + "_double_register_", first_word_register, 47)) {
+      type = RTDEFieldType::DOUBLE;
+      return true;
+    }
+  }
+  return false;
+}
+
+void RTDEOutputBinding::bind(const std::string& name, bool* destination)
+{
+  add(name, RTDEFieldType::BOOL, destination);
+}
+
+void RTDEOutputBinding::bind(const std::string& name, uint8_t* destination)
+{
+  add(name, RTDEFieldType::UINT8, destination);
+}
+
+void RTDEOutputBinding::bind(const std::string& name, uint32_t* destination)
+{
+  add(name, RTDEFieldType::UINT32, destination);
+}
+
+void RTDEOutputBinding::bind(const std::string& name, uint64_t* destination)
+{
+  add(name, RTDEFieldType::UINT64, destination);
+}
+
+void RTDEOutputBinding::bind(const std::string& name, int32_t* destination)
+{
+  add(name, RTDEFieldType::INT32, destination);
+}
+
+void RTDEOutputBinding::bind(const std::string& name, double* destination)
+{
+  add(name, RTDEFieldType::DOUBLE, destination);
+}
+
+void RTDEOutputBinding::bind(const std::string& name, urcl::vector3d_t* destination)
+{
+  add(name, RTDEFieldType::VECTOR3D, destination);
+}
+
+void RTDEOutputBinding::bind(const std::string& name, urcl::vector6d_t* destination)
+{
+  add(name, RTDEFieldType::VECTOR6D, destination);
+}
+
+void RTDEOutputBinding::bind(const std::string& name, urcl::vector6int32_t* destination)
+{
+  add(name, RTDEFieldType::VECTOR6INT32, destination);
+}
+
+void RTDEOutputBinding::bind(const std::string& name, urcl::vector6uint32_t* destination)
+{
+  add(name, RTDEFieldType::VECTOR6UINT32, destination);
+}
+
+void RTDEOutputBinding::clear()
+{
+  bindings_.clear();
+}
+
+bool RTDEOutputBinding::contains(const std::string& name) const
+{
+  return std::any_of(bindings_.begin(), bindings_.end(),
+                     [&name](const Binding& binding) { return binding.name == name; });
+}
+
+void RTDEOutputBinding::add(const std::string& name, RTDEFieldType type, void* destination)
+{
+  bindings_.push_back(Binding{ name, type, destination });
+}
+
+void RTDEOutputBinding::decode(rtde::DataPackage& data_pkg) const
+{
+  for (const Binding& binding : bindings_) {
+    bool found = false;
+    switch (binding.type) {
+      case RTDEFieldType::BOOL:
+        found = data_pkg.getData(binding.name, *static_cast<bool*>(binding.destination));
+        break;
+      case RTDEFieldType::UINT8:
+        found = data_pkg.getData(binding.name, *static_cast<uint8_t*>(binding.destination));
+        break;
+      case RTDEFieldType::UINT32:
+        found = data_pkg.getData(binding.name, *static_cast<uint32_t*>(binding.destination));
+        break;
+      case RTDEFieldType::UINT64:
+        found = data_pkg.getData(binding.name, *static_cast<uint64_t*>(binding.destination));
+        break;
+      case RTDEFieldType::INT32:
+        found = data_pkg.getData(binding.name, *static_cast<int32_t*>(binding.destination));
+        break;
+      case RTDEFieldType::DOUBLE:
+        found = data_pkg.getData(binding.name, *static_cast<double*>(binding.destination));
+        break;
+      case RTDEFieldType::VECTOR3D:
+        found = data_pkg.getData(binding.name, *static_cast<urcl::vector3d_t*>(binding.destination));
+        break;
+      case RTDEFieldType::VECTOR6D:
+        found = data_pkg.getData(binding.name, *static_cast<urcl::vector6d_t*>(binding.destination));
+        break;
+      case RTDEFieldType::VECTOR6INT32:
+        found = data_pkg.getData(binding.name, *static_cast<urcl::vector6int32_t*>(binding.destination));
+        break;
+      case RTDEFieldType::VECTOR6UINT32:
+        found = data_pkg.getData(binding.name, *static_cast<urcl::vector6uint32_t*>(binding.destination));
+        break;
+    }
+
+    if (!found) {
+      // This throwing should never happen unless misconfigured
+      throw std::runtime_error("Did not find '" + binding.name + "' in data sent from robot. This should not happen!");
+    }
+  }
+}
+
+GenericRTDEField::GenericRTDEField(const std::string& name, RTDEFieldType type)
+  : name_(name)
+  , type_(type)
+  , bool_value_(false)
+  , uint8_value_(0)
+  , uint32_value_(0)
+  , uint64_value_(0)
+  , int32_value_(0)
+  , vector3d_value_{ { 0.0, 0.0, 0.0 } }
+  , vector6int32_value_{ { 0, 0, 0, 0, 0, 0 } }
+  , vector6uint32_value_{ { 0, 0, 0, 0, 0, 0 } }
+  , values_{ { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 } }
+{
+}
+
+void GenericRTDEField::bindTo(RTDEOutputBinding& binding)
+{
+  switch (type_) {
+    case RTDEFieldType::BOOL:
+      binding.bind(name_, &bool_value_);
+      break;
+    case RTDEFieldType::UINT8:
+      binding.bind(name_, &uint8_value_);
+      break;
+    case RTDEFieldType::UINT32:
+      binding.bind(name_, &uint32_value_);
+      break;
+    case RTDEFieldType::UINT64:
+      binding.bind(name_, &uint64_value_);
+      break;
+    case RTDEFieldType::INT32:
+      binding.bind(name_, &int32_value_);
+      break;
+    case RTDEFieldType::DOUBLE:
+      binding.bind(name_, &values_[0]);
+      break;
+    case RTDEFieldType::VECTOR3D:
+      binding.bind(name_, &vector3d_value_);
+      break;
+    case RTDEFieldType::VECTOR6D:
+      binding.bind(name_, &values_);
+      break;
+    case RTDEFieldType::VECTOR6INT32:
+      binding.bind(name_, &vector6int32_value_);
+      break;
+    case RTDEFieldType::VECTOR6UINT32:
+      binding.bind(name_, &vector6uint32_value_);
+      break;
+  }
+}
+
+void GenericRTDEField::update()
+{
+  switch (type_) {
+    case RTDEFieldType::BOOL:
+      values_[0] = bool_value_ ? 1.0 : 0.0;
+      break;
+    case RTDEFieldType::UINT8:
+      values_[0] = static_cast<double>(uint8_value_);
+      break;
+    case RTDEFieldType::UINT32:
+      values_[0] = static_cast<double>(uint32_value_);
+      break;
+    case RTDEFieldType::UINT64:
+      values_[0] = static_cast<double>(uint64_value_);
+      break;
+    case RTDEFieldType::INT32:
+      values_[0] = static_cast<double>(int32_value_);
+      break;
+    case RTDEFieldType::VECTOR3D:
+      std::copy(vector3d_value_.begin(), vector3d_value_.end(), values_.begin());
+      break;
+    case RTDEFieldType::VECTOR6INT32:
+      std::copy(vector6int32_value_.begin(), vector6int32_value_.end(), values_.begin());
+      break;
+    case RTDEFieldType::VECTOR6UINT32:
+      std::copy(vector6uint32_value_.begin(), vector6uint32_value_.end(), values_.begin());
+      break;
+    case RTDEFieldType::DOUBLE:
+    case RTDEFieldType::VECTOR6D:
+      // decoded in place
+      break;
+  }
+}
+
+size_t GenericRTDEField::size() const
+{
+  switch (type_) {
+    case RTDEFieldType::VECTOR3D:
+      return 3;
+    case RTDEFieldType::VECTOR6D:
+    case RTDEFieldType::VECTOR6INT32:
+    case RTDEFieldType::VECTOR6UINT32:
+      return 6;
+    default:
+      return 1;
+  }
+}
+}  // namespace ur_robot_driver
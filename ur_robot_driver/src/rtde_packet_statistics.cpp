@@ -0,0 +1,86 @@
+// Copyright 2026 FZI Forschungszentrum Informatik
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include <cmath>
+
+#include "ur_robot_driver/rtde_packet_statistics.hpp"
+
+namespace ur_robot_driver
+{
+RTDEPacketStatistics::RTDEPacketStatistics()
+{
+  reset();
+}
+
+void RTDEPacketStatistics::reset()
+{
+  has_last_package_ = false;
+  last_timestamp_ = 0.0;
+  received_packets_.store(0, std::memory_order_relaxed);
+  missed_packets_.store(0, std::memory_order_relaxed);
+  late_packets_.store(0, std::memory_order_relaxed);
+  duplicate_packets_.store(0, std::memory_order_relaxed);
+  max_gap_.store(0.0, std::memory_order_relaxed);
+  control_step_.store(0.0, std::memory_order_relaxed);
+}
+
+void RTDEPacketStatistics::update(double robot_timestamp, std::chrono::steady_clock::time_point receive_time)
+{
+  increment(received_packets_);
+
+  const double gap = robot_timestamp - last_timestamp_;
+  const double receive_interval = std::chrono::duration<double>(receive_time - last_receive_time_).count();
+  const bool has_last_package = has_last_package_;
+  has_last_package_ = true;
+  last_timestamp_ = robot_timestamp;
+  last_receive_time_ = receive_time;
+
+  // Nothing to compare with for the first package. If the robot's clock went backwards, the robot
+  // controller was restarted and the package starts a new sequence.
+  if (!has_last_package || gap < 0.0) {
+    return;
+  }
+
+  // The learned step may still be a multiple of the actual one if packages were lost early on, so
+  // only gaps well below a step are taken for duplicates.
+  double step = control_step_.load(std::memory_order_relaxed);
+  if (step > 0.0 ? gap < 0.25 * step : gap == 0.0) {
+    increment(duplicate_packets_);
+    return;
+  }
+
+  if (step <= 0.0 || gap < step) {
+    step = gap;
+    control_step_.store(step, std::memory_order_relaxed);
+  }
+
+  if (gap > max_gap_.load(std::memory_order_relaxed)) {
+    max_gap_.store(gap, std::memory_order_relaxed);
+  }
+
+  const auto steps = std::llround(gap / step);
+  if (steps > 1) {
+    increment(missed_packets_, static_cast<uint64_t>(steps - 1));
+  } else if (receive_interval > 1.5 * step) {
+    increment(late_packets_);
+  }
+}
+}  // namespace ur_robot_driver
@@ -0,0 +1,312 @@
+// Copyright 2026 FZI Forschungszentrum Informatik
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "rclcpp/rclcpp.hpp"
+#include "ur_robot_driver/trajectory_forwarder.hpp"
+
+namespace ur_robot_driver
+{
+namespace
+{
+// [trajectory_id, index, count, positions, velocities, duration]
+constexpr size_t POINT_INTEGERS = 16;
+// [trajectory_id, points_done, result]
+constexpr size_t REPORT_INTEGERS = 3;
+// A send waiting for a robot program that stopped reading gives up this often to check for shutdown
+constexpr int SEND_TIMEOUT_MS = 100;
+
+void appendInteger(std::vector<uint8_t>& buffer, int32_t value)
+{
+  const uint32_t network = htonl(static_cast<uint32_t>(value));
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&network);
+  buffer.insert(buffer.end(), bytes, bytes + sizeof(network));
+}
+
+int32_t fixedPoint(double value)
+{
+  return static_cast<int32_t>(std::round(value * TrajectoryForwarder::MULT));
+}
+}  // namespace
+
+TrajectoryForwarder::TrajectoryForwarder()
+  : listen_fd_(-1)
+  , client_fd_(-1)
+  , event_fd_(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+  , report_bytes_(0)
+  , connected_(false)
+  , shutdown_(false)
+{
+}
+
+TrajectoryForwarder::~TrajectoryForwarder()
+{
+  stop();
+  if (event_fd_ >= 0) {
+    close(event_fd_);
+  }
+}
+
+bool TrajectoryForwarder::start(int port)
+{
+  stop();
+
+  listen_fd_ = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (listen_fd_ < 0) {
+    RCLCPP_ERROR(rclcpp::get_logger("URPositionHardwareInterface"), "Could not create the trajectory socket: %s",
+                 std::strerror(errno));
+    return false;
+  }
+  const int enable = 1;
+  setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+  sockaddr_in address;
+  std::memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_ANY);
+  address.sin_port = htons(static_cast<uint16_t>(port));
+  if (bind(listen_fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || listen(listen_fd_, 1) < 0) {
+    RCLCPP_ERROR(rclcpp::get_logger("URPositionHardwareInterface"), "Could not open the trajectory port %d: %s", port,
+                 std::strerror(errno));
+    close(listen_fd_);
+    listen_fd_ = -1;
+    return false;
+  }
+
+  shutdown_ = false;
+  thread_ = std::make_unique<std::thread>(&TrajectoryForwarder::run, this);
+  return true;
+}
+
+void TrajectoryForwarder::stop()
+{
+  if (thread_) {
+    shutdown_ = true;
+    wake();
+    if (thread_->joinable()) {
+      thread_->join();
+    }
+    thread_.reset();
+  }
+  closeClient();
+  if (listen_fd_ >= 0) {
+    close(listen_fd_);
+    listen_fd_ = -1;
+  }
+}
+
+bool TrajectoryForwarder::postPoint(const TrajectoryPoint& point)
+{
+  TrajectoryPoint item = point;
+  if (!points_.push(std::move(item))) {
+    return false;
+  }
+  wake();
+  return true;
+}
+
+bool TrajectoryForwarder::takeReport(TrajectoryReport& report)
+{
+  return reports_.pop(report);
+}
+
+void TrajectoryForwarder::run()
+{
+  while (!shutdown_) {
+    // posted points wake the worker through the eventfd, reports through the client socket
+    pollfd fds[2];
+    fds[0] = { event_fd_, POLLIN, 0 };
+    fds[1] = { client_fd_ < 0 ? listen_fd_ : client_fd_, POLLIN, 0 };
+
+    // the timeout only matters without an eventfd
+    if (poll(fds, 2, 100) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      RCLCPP_ERROR(rclcpp::get_logger("URPositionHardwareInterface"), "Polling the trajectory socket failed: %s",
+                   std::strerror(errno));
+      break;
+    }
+
+    if (fds[0].revents & POLLIN) {
+      // reset the counter, so the next poll blocks again
+      uint64_t wakeups;
+      if (read(event_fd_, &wakeups, sizeof(wakeups)) < 0) {
+        wakeups = 0;
+      }
+    }
+    if (shutdown_) {
+      break;
+    }
+
+    if (client_fd_ < 0) {
+      // Points without a robot program to execute them are outdated by the time it connects. They are
+      // dropped before accepting, so points posted once the connection is up are kept.
+      TrajectoryPoint point;
+      while (points_.pop(point)) {
+      }
+      if (fds[1].revents & POLLIN) {
+        acceptClient();
+      }
+      continue;
+    }
+
+    if (fds[1].revents & (POLLERR | POLLHUP)) {
+      RCLCPP_WARN(rclcpp::get_logger("URPositionHardwareInterface"), "Robot program closed the trajectory socket.");
+      closeClient();
+      continue;
+    }
+    if ((fds[1].revents & POLLIN) && !receiveReports()) {
+      closeClient();
+      continue;
+    }
+    if (!sendPoints()) {
+      closeClient();
+    }
+  }
+}
+
+void TrajectoryForwarder::acceptClient()
+{
+  client_fd_ = accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+  if (client_fd_ < 0) {
+    return;
+  }
+  const int enable = 1;
+  setsockopt(client_fd_, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+  timeval send_timeout;
+  send_timeout.tv_sec = 0;
+  send_timeout.tv_usec = SEND_TIMEOUT_MS * 1000;
+  setsockopt(client_fd_, SOL_SOCKET, SO_SNDTIMEO, &send_timeout, sizeof(send_timeout));
+  report_bytes_ = 0;
+  connected_ = true;
+  RCLCPP_INFO(rclcpp::get_logger("URPositionHardwareInterface"), "Robot program connected to the trajectory socket.");
+}
+
+bool TrajectoryForwarder::sendPoints()
+{
+  TrajectoryPoint point;
+  std::vector<uint8_t> buffer;
+  buffer.reserve(POINT_INTEGERS * sizeof(int32_t));
+  while (points_.pop(point)) {
+    buffer.clear();
+    appendInteger(buffer, point.trajectory_id);
+    appendInteger(buffer, point.index);
+    appendInteger(buffer, point.count);
+    for (const double position : point.positions) {
+      appendInteger(buffer, fixedPoint(position));
+    }
+    for (const double velocity : point.velocities) {
+      appendInteger(buffer, fixedPoint(velocity));
+    }
+    appendInteger(buffer, fixedPoint(point.duration));
+
+    // A point is small compared to the socket buffer, so the blocking send only waits if the robot
+    // program stopped reading. A partial point would corrupt the stream, hence no non-blocking send.
+    // The send timeout still lets stop() end the worker while it waits.
+    size_t sent = 0;
+    while (sent < buffer.size()) {
+      const ssize_t result = send(client_fd_, buffer.data() + sent, buffer.size() - sent, MSG_NOSIGNAL);
+      if (result < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+          if (shutdown_) {
+            return false;
+          }
+          continue;
+        }
+        RCLCPP_ERROR(rclcpp::get_logger("URPositionHardwareInterface"), "Sending a trajectory point failed: %s",
+                     std::strerror(errno));
+        return false;
+      }
+      sent += static_cast<size_t>(result);
+    }
+  }
+  return true;
+}
+
+bool TrajectoryForwarder::receiveReports()
+{
+  const ssize_t result =
+      recv(client_fd_, report_buffer_.data() + report_bytes_, report_buffer_.size() - report_bytes_, MSG_DONTWAIT);
+  if (result == 0) {
+    RCLCPP_WARN(rclcpp::get_logger("URPositionHardwareInterface"), "Robot program closed the trajectory socket.");
+    return false;
+  }
+  if (result < 0) {
+    return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+  }
+
+  report_bytes_ += static_cast<size_t>(result);
+  if (report_bytes_ < report_buffer_.size()) {
+    return true;
+  }
+  report_bytes_ = 0;
+
+  int32_t values[REPORT_INTEGERS];
+  for (size_t i = 0; i < REPORT_INTEGERS; ++i) {
+    uint32_t network;
+    std::memcpy(&network, report_buffer_.data() + i * sizeof(network), sizeof(network));
+    values[i] = static_cast<int32_t>(ntohl(network));
+  }
+  TrajectoryReport report{ values[0], values[1], static_cast<TrajectoryResult>(values[2]) };
+  if (!reports_.push(std::move(report))) {
+    RCLCPP_WARN(rclcpp::get_logger("URPositionHardwareInterface"), "Dropping a trajectory report.");
+  }
+  return true;
+}
+
+void TrajectoryForwarder::wake()
+{
+  if (event_fd_ < 0) {
+    return;
+  }
+  const uint64_t one = 1;
+  // a full counter still wakes the worker, so a failed write can be ignored
+  if (write(event_fd_, &one, sizeof(one)) < 0) {
+    return;
+  }
+}
+
+void TrajectoryForwarder::closeClient()
+{
+  if (client_fd_ >= 0) {
+    close(client_fd_);
+    client_fd_ = -1;
+  }
+  connected_ = false;
+}
+}  // namespace ur_robot_driver
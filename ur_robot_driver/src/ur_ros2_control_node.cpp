@@ -36,16 +36,104 @@
 //----------------------------------------------------------------------
 
 #include <pthread.h>
+#include <atomic>
+#include <chrono>
 #include <thread>
 #include <memory>
+#include <string>
 
 // ROS includes
 #include "controller_manager/controller_manager.hpp"
+#include "diagnostic_msgs/msg/diagnostic_array.hpp"
+#include "hardware_interface/loaned_state_interface.hpp"
 #include "rclcpp/rclcpp.hpp"
+#include "ur_robot_driver/latency_histogram.hpp"
 
 // code is inspired by
 // https://github.com/ros-controls/ros2_control/blob/master/controller_manager/src/ros2_control_node.cpp
 
+namespace
+{
+const char ROBOT_TIMESTAMP_INTERFACE[] = "system_interface/robot_timestamp";
+
+/*!
+ * \brief Controller manager giving the control loop access to the robot's controller clock, which
+ * the hardware interface exports as state interface.
+ */
+class URControllerManager : public controller_manager::ControllerManager
+{
+public:
+  using controller_manager::ControllerManager::ControllerManager;
+
+  /*!
+   * \brief Loans the robot timestamp interface from the resource manager. State interfaces are not
+   * exclusive, so this does not prevent any controller from reading it as well.
+   *
+   * \returns False if the hardware does not export the robot timestamp
+   */
+  bool claimRobotTimestamp()
+  {
+    if (!resource_manager_->state_interface_exists(ROBOT_TIMESTAMP_INTERFACE)) {
+      return false;
+    }
+    robot_timestamp_ = std::make_unique<hardware_interface::LoanedStateInterface>(
+        resource_manager_->claim_state_interface(ROBOT_TIMESTAMP_INTERFACE));
+    return true;
+  }
+
+  /*!
+   * \brief Robot controller time in seconds of the last read() call. Zero until the first package
+   * has been received.
+   */
+  double getRobotTimestamp() const
+  {
+    return robot_timestamp_->get_value();
+  }
+
+private:
+  std::unique_ptr<hardware_interface::LoanedStateInterface> robot_timestamp_;
+};
+
+/*!
+ * \brief Timing of the control loop, recorded by the control thread and published by the executor.
+ */
+struct ControlLoopLatency
+{
+  ur_robot_driver::LatencyHistogram read;
+  ur_robot_driver::LatencyHistogram update;
+  ur_robot_driver::LatencyHistogram write;
+  ur_robot_driver::LatencyHistogram period;
+  // loop periods exceeding the nominal period by more than half of it
+  std::atomic<uint64_t> overruns{ 0 };
+};
+
+diagnostic_msgs::msg::KeyValue makeKeyValue(const std::string& key, double value)
+{
+  diagnostic_msgs::msg::KeyValue key_value;
+  key_value.key = key;
+  key_value.value = std::to_string(value);
+  return key_value;
+}
+
+diagnostic_msgs::msg::DiagnosticStatus makeLatencyStatus(const std::string& phase,
+                                                         ur_robot_driver::LatencyHistogram& histogram)
+{
+  const ur_robot_driver::LatencyHistogram::Snapshot snapshot = histogram.snapshot();
+
+  diagnostic_msgs::msg::DiagnosticStatus status;
+  status.level = diagnostic_msgs::msg::DiagnosticStatus::OK;
+  status.name = "ur_ros2_control_node: control loop " + phase;
+  status.message = "durations in microseconds since the last message";
+  status.values.push_back(makeKeyValue("count", static_cast<double>(snapshot.count)));
+  status.values.push_back(makeKeyValue("p50", snapshot.percentile(0.5) / 1000.0));
+  status.values.push_back(makeKeyValue("p90", snapshot.percentile(0.9) / 1000.0));
+  status.values.push_back(makeKeyValue("p99", snapshot.percentile(0.99) / 1000.0));
+  status.values.push_back(makeKeyValue("p99.9", snapshot.percentile(0.999) / 1000.0));
+  status.values.push_back(makeKeyValue("max", snapshot.max / 1000.0));
+  return status;
+}
+}  // namespace
+
 int main(int argc, char** argv)
 {
   rclcpp::init(argc, argv);
@@ -53,18 +141,123 @@ int main(int argc, char** argv)
   // create executor
   std::shared_ptr<rclcpp::Executor> e = std::make_shared<rclcpp::executors::MultiThreadedExecutor>();
   // create controller manager instance
-  auto controller_manager = std::make_shared<controller_manager::ControllerManager>(e, "controller_manager");
+  auto controller_manager = std::make_shared<URControllerManager>(e, "controller_manager");
+
+  // Drive the controllers with the robot's clock instead of the host's clock. The time passed to the
+  // controllers advances by the period measured on the robot, so time integration follows the robot
+  // rather than the scheduling jitter of this process.
+  bool use_robot_clock = false;
+  if (!controller_manager->has_parameter("use_robot_clock")) {
+    controller_manager->declare_parameter("use_robot_clock", false);
+  }
+  controller_manager->get_parameter("use_robot_clock", use_robot_clock);
+  if (use_robot_clock && !controller_manager->claimRobotTimestamp()) {
+    RCLCPP_WARN(controller_manager->get_logger(),
+                "Hardware does not export '%s', using the host clock for the control loop. Add 'timestamp' to "
+                "the RTDE output recipe to use the robot clock.",
+                ROBOT_TIMESTAMP_INTERFACE);
+    use_robot_clock = false;
+  }
+
+  // Rate in Hz at which the timing of the control loop is published on ~/control_loop_latency. The
+  // timing is recorded in the control thread and published from the executor. Zero disables both.
+  double latency_publish_rate = 1.0;
+  if (!controller_manager->has_parameter("latency_publish_rate")) {
+    controller_manager->declare_parameter("latency_publish_rate", 1.0);
+  }
+  controller_manager->get_parameter("latency_publish_rate", latency_publish_rate);
+
+  std::shared_ptr<ControlLoopLatency> latency;
+  rclcpp::Publisher<diagnostic_msgs::msg::DiagnosticArray>::SharedPtr latency_publisher;
+  rclcpp::TimerBase::SharedPtr latency_timer;
+  if (latency_publish_rate > 0.0) {
+    latency = std::make_shared<ControlLoopLatency>();
+    latency_publisher = controller_manager->create_publisher<diagnostic_msgs::msg::DiagnosticArray>(
+        "~/control_loop_latency", rclcpp::SystemDefaultsQoS());
+    latency_timer = controller_manager->create_wall_timer(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(1.0 / latency_publish_rate)),
+        [controller_manager, latency, latency_publisher]() {
+          diagnostic_msgs::msg::DiagnosticArray msg;
+          msg.header.stamp = controller_manager->now();
+          msg.status.push_back(makeLatencyStatus("read", latency->read));
+          msg.status.push_back(makeLatencyStatus("update", latency->update));
+          msg.status.push_back(makeLatencyStatus("write", latency->write));
+          msg.status.push_back(makeLatencyStatus("period", latency->period));
+          msg.status.back().values.push_back(
+              makeKeyValue("overruns", static_cast<double>(latency->overruns.load(std::memory_order_relaxed))));
+          latency_publisher->publish(msg);
+        });
+  }
 
   // control loop thread
-  std::thread control_loop([controller_manager]() {
+  std::thread control_loop([controller_manager, use_robot_clock, latency]() {
     // use fixed time step
     const rclcpp::Duration dt = rclcpp::Duration::from_seconds(1.0 / controller_manager->get_update_rate());
+    const auto overrun_period = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::duration<double>(1.5 / controller_manager->get_update_rate()));
+    std::chrono::steady_clock::time_point last_loop_start;
+
+    rclcpp::Time time = controller_manager->now();
+    rclcpp::Duration period = dt;
+
+    // host time and robot time the robot clock is aligned to
+    rclcpp::Time host_time_offset = time;
+    double robot_time_offset = 0.0;
+    double last_robot_time = 0.0;
+    // the robot timestamp did not advance in the last cycle, e.g. while reconnecting
+    bool robot_time_stalled = false;
 
     while (rclcpp::ok()) {
+      const auto loop_start = std::chrono::steady_clock::now();
       // ur client library is blocking and is the one that is controlling time step
-      controller_manager->read(controller_manager->now(), dt);
-      controller_manager->update(controller_manager->now(), dt);
-      controller_manager->write(controller_manager->now(), dt);
+      controller_manager->read(time, period);
+      const auto read_end = std::chrono::steady_clock::now();
+
+      if (use_robot_clock && controller_manager->getRobotTimestamp() > 0.0) {
+        const double robot_time = controller_manager->getRobotTimestamp();
+        if (last_robot_time <= 0.0 || robot_time < last_robot_time) {
+          // first package or the robot controller restarted, align both clocks again
+          host_time_offset = controller_manager->now();
+          robot_time_offset = robot_time;
+          period = dt;
+          robot_time_stalled = false;
+        } else if (robot_time == last_robot_time || robot_time_stalled) {
+          // Without a new robot timestamp the controllers would get a period of zero, so they continue
+          // with the host clock. The clocks are aligned again once the robot timestamp advances.
+          const rclcpp::Time now = controller_manager->now();
+          period = now > time ? now - time : dt;
+          host_time_offset = now;
+          robot_time_offset = robot_time;
+          robot_time_stalled = robot_time == last_robot_time;
+        } else {
+          period = rclcpp::Duration::from_seconds(robot_time - last_robot_time);
+        }
+        last_robot_time = robot_time;
+        // stay in the host's time domain, so stamps remain comparable with other ROS time stamps
+        time = host_time_offset + rclcpp::Duration::from_seconds(robot_time - robot_time_offset);
+      } else {
+        time = controller_manager->now();
+        period = dt;
+      }
+
+      controller_manager->update(time, period);
+      const auto update_end = std::chrono::steady_clock::now();
+      controller_manager->write(time, period);
+
+      if (latency) {
+        const auto write_end = std::chrono::steady_clock::now();
+        latency->read.record(read_end - loop_start);
+        latency->update.record(update_end - read_end);
+        latency->write.record(write_end - update_end);
+        if (last_loop_start.time_since_epoch().count() != 0) {
+          const auto loop_period = loop_start - last_loop_start;
+          latency->period.record(loop_period);
+          if (loop_period > overrun_period) {
+            latency->overruns.store(latency->overruns.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+          }
+        }
+        last_loop_start = loop_start;
+      }
     }
   });
 
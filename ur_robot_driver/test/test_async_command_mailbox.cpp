@@ -0,0 +1,216 @@
+// Copyright 2026 FZI Forschungszentrum Informatik
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <thread>
+
+#include "ur_robot_driver/async_command_mailbox.hpp"
+#include "ur_robot_driver/spsc_queue.hpp"
+
+using ur_robot_driver::AsyncCommand;
+using ur_robot_driver::AsyncCommandMailbox;
+using ur_robot_driver::AsyncCommandResult;
+using ur_robot_driver::SentSequence;
+using ur_robot_driver::SPSCQueue;
+using ur_robot_driver::StreamedRegisters;
+
+TEST(SPSCQueueTest, holds_one_element_less_than_its_slots)
+{
+  SPSCQueue<int, 4> queue;
+  EXPECT_TRUE(queue.empty());
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_TRUE(queue.push(int(i)));
+  }
+  int item = 42;
+  EXPECT_FALSE(queue.push(std::move(item)));
+  // a rejected element is left untouched
+  EXPECT_EQ(item, 42);
+
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_TRUE(queue.pop(item));
+    EXPECT_EQ(item, i);
+  }
+  EXPECT_FALSE(queue.pop(item));
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(SPSCQueueTest, keeps_the_order_across_wraparound)
+{
+  SPSCQueue<int, 4> queue;
+  int next_push = 0;
+  int next_pop = 0;
+  // push two and pop one per round, so head and tail wrap around several times at different offsets
+  for (int round = 0; round < 20; ++round) {
+    for (int i = 0; i < 2; ++i) {
+      if (queue.push(int(next_push))) {
+        ++next_push;
+      }
+    }
+    int item;
+    ASSERT_TRUE(queue.pop(item));
+    EXPECT_EQ(item, next_pop++);
+  }
+  int item;
+  while (queue.pop(item)) {
+    EXPECT_EQ(item, next_pop++);
+  }
+  EXPECT_EQ(next_pop, next_push);
+}
+
+TEST(SPSCQueueTest, moves_elements_between_threads)
+{
+  SPSCQueue<std::unique_ptr<int>, 8> queue;
+  constexpr int COUNT = 100000;
+  std::thread producer([&queue]() {
+    for (int i = 0; i < COUNT; ++i) {
+      auto item = std::make_unique<int>(i);
+      while (!queue.push(std::move(item))) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  int expected = 0;
+  std::unique_ptr<int> item;
+  while (expected < COUNT) {
+    if (queue.pop(item)) {
+      ASSERT_NE(item, nullptr);
+      ASSERT_EQ(*item, expected);
+      ++expected;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(AsyncCommandMailboxTest, passes_commands_and_results_in_order)
+{
+  AsyncCommandMailbox mailbox;
+  EXPECT_TRUE(mailbox.postCommand({ AsyncCommand::Type::SPEED_SLIDER, 0, 0, { 0.5, 0.0, 0.0, 0.0 }, 0 }));
+  EXPECT_TRUE(mailbox.postCommand({ AsyncCommand::Type::SET_OUTPUTS, 0x3, 0x1, { 1.0, 2.0, 0.0, 0.0 }, 0 }));
+
+  AsyncCommand command;
+  ASSERT_TRUE(mailbox.takeCommand(command));
+  EXPECT_EQ(command.type, AsyncCommand::Type::SPEED_SLIDER);
+  EXPECT_EQ(command.values[0], 0.5);
+  ASSERT_TRUE(mailbox.takeCommand(command));
+  EXPECT_EQ(command.type, AsyncCommand::Type::SET_OUTPUTS);
+  EXPECT_EQ(command.digital_output_mask, 0x3u);
+  EXPECT_EQ(command.digital_output_bits, 0x1u);
+  EXPECT_FALSE(mailbox.takeCommand(command));
+
+  EXPECT_TRUE(mailbox.postResult({ AsyncCommand::Type::SET_OUTPUTS, true }));
+  AsyncCommandResult result;
+  ASSERT_TRUE(mailbox.takeResult(result));
+  EXPECT_EQ(result.type, AsyncCommand::Type::SET_OUTPUTS);
+  EXPECT_TRUE(result.success);
+  EXPECT_FALSE(mailbox.takeResult(result));
+}
+
+TEST(AsyncCommandMailboxTest, rejects_commands_when_full)
+{
+  AsyncCommandMailbox mailbox;
+  size_t posted = 0;
+  while (mailbox.postCommand({ AsyncCommand::Type::RESEND_ROBOT_PROGRAM, 0, 0, { 0.0, 0.0, 0.0, 0.0 }, 0 })) {
+    ++posted;
+    ASSERT_LT(posted, AsyncCommandMailbox::CAPACITY);
+  }
+  EXPECT_EQ(posted, AsyncCommandMailbox::CAPACITY - 1);
+
+  // taking one makes room for the next
+  AsyncCommand command;
+  ASSERT_TRUE(mailbox.takeCommand(command));
+  EXPECT_TRUE(mailbox.postCommand({ AsyncCommand::Type::RESEND_ROBOT_PROGRAM, 0, 0, { 0.0, 0.0, 0.0, 0.0 }, 0 }));
+}
+
+TEST(AsyncCommandMailboxTest, passes_streamed_registers_and_sent_sequences)
+{
+  AsyncCommandMailbox mailbox;
+  StreamedRegisters registers{ true, {}, 0x5, 2, 7, {}, 300.0, 0.1 };
+  registers.force_mode_values.fill(1.5);
+  registers.register_values.fill(std::numeric_limits<double>::quiet_NaN());
+  registers.register_values[0] = 3.0;
+  EXPECT_TRUE(mailbox.postRegisters(registers));
+  registers.resend = false;
+  registers.command_seq = 8;
+  EXPECT_TRUE(mailbox.postRegisters(registers));
+
+  StreamedRegisters received;
+  ASSERT_TRUE(mailbox.takeRegisters(received));
+  EXPECT_TRUE(received.resend);
+  EXPECT_EQ(received.command_seq, 7);
+  ASSERT_TRUE(mailbox.takeRegisters(received));
+  EXPECT_FALSE(received.resend);
+  EXPECT_EQ(received.command_seq, 8);
+  EXPECT_EQ(received.force_mode_selection, 0x5);
+  EXPECT_EQ(received.force_mode_type, 2);
+  EXPECT_EQ(received.force_mode_values[17], 1.5);
+  EXPECT_EQ(received.register_values[0], 3.0);
+  EXPECT_TRUE(std::isnan(received.register_values[1]));
+  EXPECT_EQ(received.servoj_gain, 300.0);
+  EXPECT_EQ(received.servoj_lookahead_time, 0.1);
+  EXPECT_FALSE(mailbox.takeRegisters(received));
+
+  const auto send_time = std::chrono::steady_clock::now();
+  EXPECT_TRUE(mailbox.postSentSequence({ SentSequence::Type::LATENCY_PROBE, 3, send_time, 11 }));
+  SentSequence sent;
+  ASSERT_TRUE(mailbox.takeSentSequence(sent));
+  EXPECT_EQ(sent.type, SentSequence::Type::LATENCY_PROBE);
+  EXPECT_EQ(sent.seq, 3);
+  EXPECT_EQ(sent.send_time, send_time);
+  EXPECT_EQ(sent.write_cycle, 11u);
+  EXPECT_FALSE(mailbox.takeSentSequence(sent));
+}
+
+TEST(AsyncCommandMailboxTest, posting_wakes_the_worker)
+{
+  AsyncCommandMailbox mailbox;
+  // without anything posted the worker sleeps until the timeout
+  auto start = std::chrono::steady_clock::now();
+  mailbox.wait(std::chrono::milliseconds(50));
+  EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(40));
+
+  mailbox.postCommand({ AsyncCommand::Type::SPEED_SLIDER, 0, 0, { 1.0, 0.0, 0.0, 0.0 }, 0 });
+  start = std::chrono::steady_clock::now();
+  mailbox.wait(std::chrono::seconds(5));
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+
+  // the wakeup is consumed, so the next wait blocks again
+  start = std::chrono::steady_clock::now();
+  mailbox.wait(std::chrono::milliseconds(50));
+  EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(40));
+
+  std::thread waker([&mailbox]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    mailbox.wake();
+  });
+  start = std::chrono::steady_clock::now();
+  mailbox.wait(std::chrono::seconds(5));
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+  waker.join();
+}
@@ -0,0 +1,106 @@
+// Copyright 2026 FZI Forschungszentrum Informatik
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ur_client_library/rtde/data_package.h"
+#include "ur_robot_driver/data_package_recycler.hpp"
+
+using ur_robot_driver::DataPackageRecycler;
+using urcl::rtde_interface::DataPackage;
+
+namespace
+{
+std::unique_ptr<DataPackage> makePackage()
+{
+  return std::make_unique<DataPackage>(std::vector<std::string>{ "timestamp" });
+}
+}  // namespace
+
+TEST(DataPackageRecyclerTest, releases_recycled_packages_on_drain)
+{
+  DataPackageRecycler recycler;
+  for (int i = 0; i < 10; ++i) {
+    recycler.recycle(makePackage());
+  }
+
+  EXPECT_EQ(recycler.drain(), 10u);
+  EXPECT_EQ(recycler.drain(), 0u);
+  EXPECT_EQ(recycler.getControlThreadAllocations(), 0u);
+}
+
+TEST(DataPackageRecyclerTest, ignores_empty_packages)
+{
+  DataPackageRecycler recycler;
+  recycler.recycle(nullptr);
+
+  EXPECT_EQ(recycler.drain(), 0u);
+  EXPECT_EQ(recycler.getControlThreadAllocations(), 0u);
+}
+
+TEST(DataPackageRecyclerTest, counts_releases_on_the_control_thread_when_full)
+{
+  DataPackageRecycler recycler;
+  const size_t recycled = DataPackageRecycler::CAPACITY + 5;
+  for (size_t i = 0; i < recycled; ++i) {
+    recycler.recycle(makePackage());
+  }
+
+  const size_t drained = recycler.drain();
+  EXPECT_LT(drained, recycled);
+  EXPECT_EQ(recycler.getControlThreadAllocations(), recycled - drained);
+
+  // Once drained, the ring takes packages again without falling back
+  const uint64_t allocations = recycler.getControlThreadAllocations();
+  recycler.recycle(makePackage());
+  EXPECT_EQ(recycler.drain(), 1u);
+  EXPECT_EQ(recycler.getControlThreadAllocations(), allocations);
+}
+
+TEST(DataPackageRecyclerTest, releases_every_package_exactly_once_with_concurrent_drain)
+{
+  DataPackageRecycler recycler;
+  const size_t recycled = 10000;
+  std::atomic<bool> done{ false };
+  size_t drained = 0;
+
+  std::thread release_thread([&]() {
+    while (!done.load()) {
+      drained += recycler.drain();
+      std::this_thread::yield();
+    }
+  });
+
+  for (size_t i = 0; i < recycled; ++i) {
+    recycler.recycle(makePackage());
+  }
+  done = true;
+  release_thread.join();
+  drained += recycler.drain();
+
+  EXPECT_EQ(drained + recycler.getControlThreadAllocations(), recycled);
+}
@@ -0,0 +1,163 @@
+// Copyright 2026 FZI Forschungszentrum Informatik
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include "ur_robot_driver/latency_histogram.hpp"
+
+using ur_robot_driver::LatencyHistogram;
+
+TEST(LatencyHistogramTest, small_values_have_a_bucket_of_their_own)
+{
+  for (uint64_t value = 0; value < LatencyHistogram::SUB_BUCKETS; ++value) {
+    EXPECT_EQ(LatencyHistogram::bucketIndex(value), value);
+    EXPECT_EQ(LatencyHistogram::bucketUpperBound(value), value);
+  }
+}
+
+TEST(LatencyHistogramTest, buckets_cover_values_without_gaps)
+{
+  // every value lies above the previous bucket and within its own one
+  for (uint64_t value = 1; value < (uint64_t(1) << 20); value += 1 + value / 64) {
+    const size_t index = LatencyHistogram::bucketIndex(value);
+    ASSERT_LT(index, LatencyHistogram::BUCKETS);
+    EXPECT_LE(value, LatencyHistogram::bucketUpperBound(index)) << "value " << value;
+    EXPECT_GT(value, LatencyHistogram::bucketUpperBound(index - 1)) << "value " << value;
+  }
+}
+
+TEST(LatencyHistogramTest, bucket_boundaries_are_consecutive)
+{
+  for (size_t index = 1; index < LatencyHistogram::BUCKETS; ++index) {
+    const uint64_t lower = LatencyHistogram::bucketUpperBound(index - 1) + 1;
+    EXPECT_EQ(LatencyHistogram::bucketLowerBound(index), lower);
+    EXPECT_EQ(LatencyHistogram::bucketIndex(lower), index);
+    EXPECT_EQ(LatencyHistogram::bucketIndex(LatencyHistogram::bucketUpperBound(index)), index);
+  }
+}
+
+TEST(LatencyHistogramTest, relative_precision_is_one_sixteenth)
+{
+  for (uint64_t value = LatencyHistogram::SUB_BUCKETS; value < (uint64_t(1) << 30); value = value * 3 + 7) {
+    const uint64_t upper = LatencyHistogram::bucketUpperBound(LatencyHistogram::bucketIndex(value));
+    EXPECT_LE(static_cast<double>(upper - value), static_cast<double>(value) / LatencyHistogram::SUB_BUCKETS)
+        << "value " << value;
+  }
+}
+
+TEST(LatencyHistogramTest, long_durations_share_the_last_bucket)
+{
+  EXPECT_EQ(LatencyHistogram::bucketIndex(uint64_t(1) << LatencyHistogram::MAX_EXPONENT),
+            LatencyHistogram::BUCKETS - 1);
+  EXPECT_EQ(LatencyHistogram::bucketIndex(UINT64_MAX), LatencyHistogram::BUCKETS - 1);
+  EXPECT_LT(LatencyHistogram::bucketIndex((uint64_t(1) << LatencyHistogram::MAX_EXPONENT) - 1),
+            LatencyHistogram::BUCKETS);
+}
+
+TEST(LatencyHistogramTest, empty_snapshot_reports_zero)
+{
+  LatencyHistogram histogram;
+  const LatencyHistogram::Snapshot snapshot = histogram.snapshot();
+  EXPECT_EQ(snapshot.count, 0u);
+  EXPECT_EQ(snapshot.max, 0u);
+  EXPECT_EQ(snapshot.percentile(0.5), 0u);
+}
+
+TEST(LatencyHistogramTest, percentile_reports_the_upper_bound_of_the_bucket)
+{
+  LatencyHistogram histogram;
+  // 99 fast cycles of 100 us and one slow of 5 ms
+  for (int i = 0; i < 99; ++i) {
+    histogram.record(std::chrono::microseconds(100));
+  }
+  histogram.record(std::chrono::milliseconds(5));
+
+  const LatencyHistogram::Snapshot snapshot = histogram.snapshot();
+  EXPECT_EQ(snapshot.count, 100u);
+  EXPECT_EQ(snapshot.max, 5000000u);
+
+  const uint64_t p50 = snapshot.percentile(0.5);
+  EXPECT_GE(p50, 100000u);
+  EXPECT_LE(p50, 100000u + 100000u / LatencyHistogram::SUB_BUCKETS);
+  EXPECT_EQ(snapshot.percentile(0.99), p50);
+  // the upper bound of the slowest bucket is capped by the largest value
+  EXPECT_EQ(snapshot.percentile(1.0), 5000000u);
+}
+
+TEST(LatencyHistogramTest, negative_durations_count_as_zero)
+{
+  LatencyHistogram histogram;
+  histogram.record(std::chrono::nanoseconds(-10));
+  const LatencyHistogram::Snapshot snapshot = histogram.snapshot();
+  EXPECT_EQ(snapshot.counts[0], 1u);
+  EXPECT_EQ(snapshot.max, 0u);
+}
+
+TEST(LatencyHistogramTest, snapshot_starts_a_new_interval)
+{
+  LatencyHistogram histogram;
+  histogram.record(std::chrono::milliseconds(1));
+  histogram.snapshot();
+
+  histogram.record(std::chrono::microseconds(10));
+  histogram.record(std::chrono::microseconds(20));
+  const LatencyHistogram::Snapshot snapshot = histogram.snapshot();
+  EXPECT_EQ(snapshot.count, 2u);
+  EXPECT_EQ(snapshot.max, 20000u);
+  EXPECT_LE(snapshot.percentile(1.0), 20000u);
+}
+
+TEST(LatencyHistogramTest, concurrent_snapshots_keep_the_maximum_above_the_counted_values)
+{
+  LatencyHistogram histogram;
+  constexpr uint64_t SAMPLES = 200000;
+  std::atomic<bool> done(false);
+  std::thread recorder([&histogram, &done]() {
+    for (uint64_t i = 0; i < SAMPLES; ++i) {
+      // alternate between large and small values, so a small one regularly follows a large maximum
+      histogram.record(std::chrono::nanoseconds(i % 2 == 0 ? 100000 + i % 1000 : 100 + i % 50));
+    }
+    done = true;
+  });
+
+  uint64_t total = 0;
+  uint64_t too_small_maxima = 0;
+  bool finished = false;
+  while (!finished) {
+    finished = done;
+    const LatencyHistogram::Snapshot snapshot = histogram.snapshot();
+    total += snapshot.count;
+    for (size_t i = LatencyHistogram::BUCKETS; i > 0; --i) {
+      if (snapshot.counts[i - 1] > 0) {
+        too_small_maxima += snapshot.max < LatencyHistogram::bucketLowerBound(i - 1) ? 1 : 0;
+        break;
+      }
+    }
+  }
+  recorder.join();
+  EXPECT_EQ(too_small_maxima, 0u);
+  EXPECT_EQ(total + histogram.snapshot().count, SAMPLES);
+}
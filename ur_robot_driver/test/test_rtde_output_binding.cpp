@@ -0,0 +1,223 @@
+// Copyright 2026 FZI Forschungszentrum Informatik
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "ur_client_library/rtde/data_package.h"
+#include "ur_robot_driver/rtde_output_binding.hpp"
+
+using ur_robot_driver::GenericRTDEField;
+using ur_robot_driver::RTDEFieldType;
+using ur_robot_driver::RTDEOutputBinding;
+using urcl::rtde_interface::DataPackage;
+
+TEST(RTDEOutputBindingTest, reads_recipe_without_blank_lines_and_whitespace)
+{
+  char filename[] = "/tmp/rtde_recipe_XXXXXX";
+  const int fd = mkstemp(filename);
+  ASSERT_NE(fd, -1);
+  close(fd);
+  {
+    std::ofstream file(filename);
+    file << "timestamp\n\n  actual_q \t\r\nspeed_scaling";
+  }
+
+  const std::vector<std::string> recipe = RTDEOutputBinding::readRecipe(filename);
+  std::remove(filename);
+
+  const std::vector<std::string> expected = { "timestamp", "actual_q", "speed_scaling" };
+  EXPECT_EQ(recipe, expected);
+}
+
+TEST(RTDEOutputBindingTest, throws_on_missing_recipe_file)
+{
+  EXPECT_THROW(RTDEOutputBinding::readRecipe("/nonexistent/rtde_recipe.txt"), std::runtime_error);
+}
+
+TEST(RTDEOutputBindingTest, decodes_bound_fields_into_their_destinations)
+{
+  DataPackage data_pkg({ "timestamp", "actual_q", "robot_mode", "actual_digital_input_bits", "runtime_state" });
+  data_pkg.initEmpty();
+  double timestamp = 12.5;
+  urcl::vector6d_t actual_q = { { 0.1, 0.2, 0.3, 0.4, 0.5, 0.6 } };
+  int32_t robot_mode = 7;
+  uint64_t digital_inputs = 0x30005;
+  uint32_t runtime_state = 2;
+  ASSERT_TRUE(data_pkg.setData("timestamp", timestamp));
+  ASSERT_TRUE(data_pkg.setData("actual_q", actual_q));
+  ASSERT_TRUE(data_pkg.setData("robot_mode", robot_mode));
+  ASSERT_TRUE(data_pkg.setData("actual_digital_input_bits", digital_inputs));
+  ASSERT_TRUE(data_pkg.setData("runtime_state", runtime_state));
+
+  double decoded_timestamp = 0.0;
+  urcl::vector6d_t decoded_q = { { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 } };
+  int32_t decoded_robot_mode = 0;
+  uint64_t decoded_digital_inputs = 0;
+  uint32_t decoded_runtime_state = 0;
+
+  RTDEOutputBinding binding;
+  binding.bind("timestamp", &decoded_timestamp);
+  binding.bind("actual_q", &decoded_q);
+  binding.bind("robot_mode", &decoded_robot_mode);
+  binding.bind("actual_digital_input_bits", &decoded_digital_inputs);
+  binding.bind("runtime_state", &decoded_runtime_state);
+  EXPECT_EQ(binding.size(), 5u);
+
+  binding.decode(data_pkg);
+  EXPECT_DOUBLE_EQ(decoded_timestamp, timestamp);
+  EXPECT_EQ(decoded_q, actual_q);
+  EXPECT_EQ(decoded_robot_mode, robot_mode);
+  EXPECT_EQ(decoded_digital_inputs, digital_inputs);
+  EXPECT_EQ(decoded_runtime_state, runtime_state);
+}
+
+TEST(RTDEOutputBindingTest, ignores_package_fields_that_are_not_bound)
+{
+  DataPackage data_pkg({ "timestamp", "speed_scaling" });
+  data_pkg.initEmpty();
+  double speed_scaling = 0.5;
+  ASSERT_TRUE(data_pkg.setData("speed_scaling", speed_scaling));
+
+  double decoded_speed_scaling = 1.0;
+  RTDEOutputBinding binding;
+  binding.bind("speed_scaling", &decoded_speed_scaling);
+
+  binding.decode(data_pkg);
+  EXPECT_DOUBLE_EQ(decoded_speed_scaling, 0.5);
+}
+
+TEST(RTDEOutputBindingTest, throws_if_bound_field_is_missing_in_package)
+{
+  DataPackage data_pkg({ "timestamp" });
+  data_pkg.initEmpty();
+
+  double speed_scaling = 1.0;
+  RTDEOutputBinding binding;
+  binding.bind("speed_scaling", &speed_scaling);
+
+  EXPECT_THROW(binding.decode(data_pkg), std::runtime_error);
+}
+
+TEST(RTDEOutputBindingTest, contains_only_bound_fields_until_cleared)
+{
+  double timestamp = 0.0;
+  RTDEOutputBinding binding;
+  binding.bind("timestamp", &timestamp);
+
+  EXPECT_TRUE(binding.contains("timestamp"));
+  EXPECT_FALSE(binding.contains("actual_q"));
+
+  binding.clear();
+  EXPECT_EQ(binding.size(), 0u);
+  EXPECT_FALSE(binding.contains("timestamp"));
+}
+
+TEST(RTDEOutputBindingTest, looks_up_types_of_known_output_fields)
+{
+  RTDEFieldType type;
+  ASSERT_TRUE(RTDEOutputBinding::lookupFieldType("actual_q", type));
+  EXPECT_EQ(type, RTDEFieldType::VECTOR6D);
+  ASSERT_TRUE(RTDEOutputBinding::lookupFieldType("runtime_state", type));
+  EXPECT_EQ(type, RTDEFieldType::UINT32);
+  ASSERT_TRUE(RTDEOutputBinding::lookupFieldType("joint_mode", type));
+  EXPECT_EQ(type, RTDEFieldType::VECTOR6INT32);
+
+  EXPECT_FALSE(RTDEOutputBinding::lookupFieldType("no_such_field", type));
+}
+
+TEST(RTDEOutputBindingTest, looks_up_register_types_within_their_ranges)
+{
+  RTDEFieldType type;
+  ASSERT_TRUE(RTDEOutputBinding::lookupFieldType("output_bit_register_64", type));
+  EXPECT_EQ(type, RTDEFieldType::BOOL);
+  EXPECT_FALSE(RTDEOutputBinding::lookupFieldType("output_bit_register_63", type));
+  EXPECT_FALSE(RTDEOutputBinding::lookupFieldType("output_bit_register_128", type));
+
+  ASSERT_TRUE(RTDEOutputBinding::lookupFieldType("output_int_register_0", type));
+  EXPECT_EQ(type, RTDEFieldType::INT32);
+  ASSERT_TRUE(RTDEOutputBinding::lookupFieldType("output_double_register_47", type));
+  EXPECT_EQ(type, RTDEFieldType::DOUBLE);
+  EXPECT_FALSE(RTDEOutputBinding::lookupFieldType("output_double_register_48", type));
+
+  // The lower half of the input registers belongs to the fieldbus adapters
+  EXPECT_FALSE(RTDEOutputBinding::lookupFieldType("input_int_register_23", type));
+  EXPECT_TRUE(RTDEOutputBinding::lookupFieldType("input_int_register_24", type));
+  EXPECT_FALSE(RTDEOutputBinding::lookupFieldType("input_double_register_x", type));
+}
+
+TEST(GenericRTDEFieldTest, converts_integer_fields_to_double)
+{
+  DataPackage data_pkg({ "robot_status_bits", "tool_output_voltage" });
+  data_pkg.initEmpty();
+  uint32_t status_bits = 3;
+  int32_t output_voltage = 24;
+  ASSERT_TRUE(data_pkg.setData("robot_status_bits", status_bits));
+  ASSERT_TRUE(data_pkg.setData("tool_output_voltage", output_voltage));
+
+  GenericRTDEField status_field("robot_status_bits", RTDEFieldType::UINT32);
+  GenericRTDEField voltage_field("tool_output_voltage", RTDEFieldType::INT32);
+  RTDEOutputBinding binding;
+  status_field.bindTo(binding);
+  voltage_field.bindTo(binding);
+
+  binding.decode(data_pkg);
+  status_field.update();
+  voltage_field.update();
+  EXPECT_EQ(status_field.size(), 1u);
+  EXPECT_DOUBLE_EQ(*status_field.value(0), 3.0);
+  EXPECT_DOUBLE_EQ(*voltage_field.value(0), 24.0);
+}
+
+TEST(GenericRTDEFieldTest, exports_every_element_of_vector_fields)
+{
+  DataPackage data_pkg({ "elbow_position", "target_qd" });
+  data_pkg.initEmpty();
+  urcl::vector3d_t elbow_position = { { 1.0, 2.0, 3.0 } };
+  urcl::vector6d_t target_qd = { { 0.1, 0.2, 0.3, 0.4, 0.5, 0.6 } };
+  ASSERT_TRUE(data_pkg.setData("elbow_position", elbow_position));
+  ASSERT_TRUE(data_pkg.setData("target_qd", target_qd));
+
+  GenericRTDEField elbow_field("elbow_position", RTDEFieldType::VECTOR3D);
+  GenericRTDEField target_qd_field("target_qd", RTDEFieldType::VECTOR6D);
+  RTDEOutputBinding binding;
+  elbow_field.bindTo(binding);
+  target_qd_field.bindTo(binding);
+
+  binding.decode(data_pkg);
+  elbow_field.update();
+  target_qd_field.update();
+  ASSERT_EQ(elbow_field.size(), 3u);
+  ASSERT_EQ(target_qd_field.size(), 6u);
+  for (size_t i = 0; i < elbow_field.size(); ++i) {
+    EXPECT_DOUBLE_EQ(*elbow_field.value(i), elbow_position[i]);
+  }
+  for (size_t i = 0; i < target_qd_field.size(); ++i) {
+    EXPECT_DOUBLE_EQ(*target_qd_field.value(i), target_qd[i]);
+  }
+}
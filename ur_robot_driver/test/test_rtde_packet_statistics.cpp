@@ -0,0 +1,147 @@
+// Copyright 2026 FZI Forschungszentrum Informatik
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "ur_robot_driver/rtde_packet_statistics.hpp"
+
+using ur_robot_driver::RTDEPacketStatistics;
+
+namespace
+{
+// control step of an e-series robot
+constexpr double STEP = 0.002;
+const std::chrono::microseconds STEP_DURATION(2000);
+}  // namespace
+
+class RTDEPacketStatisticsTest : public ::testing::Test
+{
+protected:
+  // Feeds a package stamped \p steps control steps after the previous one, arriving \p interval
+  // after it.
+  void receive(int steps, std::chrono::microseconds interval)
+  {
+    timestamp_ += steps * STEP;
+    receive_time_ += interval;
+    statistics_.update(timestamp_, receive_time_);
+  }
+
+  void receiveOnTime(int packages)
+  {
+    for (int i = 0; i < packages; ++i) {
+      receive(1, STEP_DURATION);
+    }
+  }
+
+  RTDEPacketStatistics statistics_;
+  double timestamp_ = 1000.0;
+  std::chrono::steady_clock::time_point receive_time_;
+};
+
+TEST_F(RTDEPacketStatisticsTest, regular_packages_are_not_flagged)
+{
+  receiveOnTime(100);
+  EXPECT_EQ(statistics_.getReceivedPackets(), 100u);
+  EXPECT_EQ(statistics_.getMissedPackets(), 0u);
+  EXPECT_EQ(statistics_.getLatePackets(), 0u);
+  EXPECT_EQ(statistics_.getDuplicatePackets(), 0u);
+  EXPECT_NEAR(statistics_.getControlStep(), STEP, 1e-9);
+  EXPECT_NEAR(statistics_.getMaxGap(), STEP, 1e-9);
+}
+
+TEST_F(RTDEPacketStatisticsTest, gap_counts_the_missed_packages)
+{
+  receiveOnTime(10);
+  // three packages lost on the way
+  receive(4, 4 * STEP_DURATION);
+  EXPECT_EQ(statistics_.getMissedPackets(), 3u);
+  EXPECT_EQ(statistics_.getLatePackets(), 0u);
+  EXPECT_NEAR(statistics_.getMaxGap(), 4 * STEP, 1e-9);
+}
+
+TEST_F(RTDEPacketStatisticsTest, package_arriving_late_is_late_but_not_missed)
+{
+  receiveOnTime(10);
+  receive(1, 3 * STEP_DURATION);
+  EXPECT_EQ(statistics_.getLatePackets(), 1u);
+  EXPECT_EQ(statistics_.getMissedPackets(), 0u);
+
+  // slightly late packages are within the tolerance of 1.5 steps
+  receive(1, std::chrono::microseconds(2900));
+  EXPECT_EQ(statistics_.getLatePackets(), 1u);
+}
+
+TEST_F(RTDEPacketStatisticsTest, same_timestamp_is_a_duplicate)
+{
+  receiveOnTime(10);
+  receive(0, std::chrono::microseconds(10));
+  EXPECT_EQ(statistics_.getDuplicatePackets(), 1u);
+  EXPECT_EQ(statistics_.getMissedPackets(), 0u);
+  EXPECT_NEAR(statistics_.getControlStep(), STEP, 1e-9);
+  // a duplicate does not disturb the following package
+  receive(1, STEP_DURATION);
+  EXPECT_EQ(statistics_.getLatePackets(), 0u);
+  EXPECT_EQ(statistics_.getMissedPackets(), 0u);
+}
+
+TEST_F(RTDEPacketStatisticsTest, step_is_learned_from_the_smallest_gap)
+{
+  // starting with a gap of two steps, which cannot be told apart from the step yet
+  receiveOnTime(1);
+  receive(2, 2 * STEP_DURATION);
+  EXPECT_NEAR(statistics_.getControlStep(), 2 * STEP, 1e-9);
+  EXPECT_EQ(statistics_.getMissedPackets(), 0u);
+
+  receiveOnTime(5);
+  EXPECT_NEAR(statistics_.getControlStep(), STEP, 1e-9);
+  receive(3, 3 * STEP_DURATION);
+  EXPECT_EQ(statistics_.getMissedPackets(), 2u);
+}
+
+TEST_F(RTDEPacketStatisticsTest, clock_going_backwards_starts_a_new_sequence)
+{
+  receiveOnTime(10);
+  // the robot controller restarted
+  timestamp_ = 0.0;
+  receive(1, 100 * STEP_DURATION);
+  EXPECT_EQ(statistics_.getMissedPackets(), 0u);
+  EXPECT_EQ(statistics_.getLatePackets(), 0u);
+  receiveOnTime(10);
+  EXPECT_EQ(statistics_.getMissedPackets(), 0u);
+  EXPECT_EQ(statistics_.getLatePackets(), 0u);
+}
+
+TEST_F(RTDEPacketStatisticsTest, reset_forgets_the_last_package)
+{
+  receiveOnTime(10);
+  receive(5, 5 * STEP_DURATION);
+  statistics_.reset();
+  EXPECT_EQ(statistics_.getReceivedPackets(), 0u);
+  EXPECT_EQ(statistics_.getMissedPackets(), 0u);
+  EXPECT_EQ(statistics_.getControlStep(), 0.0);
+
+  // the first package after the reset has nothing to be compared with
+  receive(50, 50 * STEP_DURATION);
+  EXPECT_EQ(statistics_.getMissedPackets(), 0u);
+  EXPECT_EQ(statistics_.getReceivedPackets(), 1u);
+}
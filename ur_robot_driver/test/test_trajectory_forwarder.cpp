@@ -0,0 +1,226 @@
+// Copyright 2026 FZI Forschungszentrum Informatik
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include <gtest/gtest.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "ur_robot_driver/trajectory_forwarder.hpp"
+
+using ur_robot_driver::TrajectoryForwarder;
+using ur_robot_driver::TrajectoryPoint;
+using ur_robot_driver::TrajectoryReport;
+using ur_robot_driver::TrajectoryResult;
+
+namespace
+{
+// [trajectory_id, index, count, positions, velocities, duration]
+constexpr size_t POINT_INTEGERS = 16;
+
+template <typename Predicate>
+bool waitFor(Predicate predicate, std::chrono::milliseconds timeout = std::chrono::milliseconds(2000))
+{
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  while (!predicate()) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+}  // namespace
+
+/*!
+ * \brief Plays the robot program on the other end of the trajectory socket.
+ */
+class TrajectoryForwarderTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    // the first free port of a range unlikely to be used otherwise
+    for (port_ = 50130; port_ < 50230; ++port_) {
+      if (forwarder_.start(port_)) {
+        return;
+      }
+    }
+    FAIL() << "No free port for the trajectory socket";
+  }
+
+  void TearDown() override
+  {
+    forwarder_.stop();
+    if (client_fd_ >= 0) {
+      close(client_fd_);
+    }
+  }
+
+  void connectClient(int receive_buffer = 0)
+  {
+    client_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_GE(client_fd_, 0);
+    if (receive_buffer > 0) {
+      setsockopt(client_fd_, SOL_SOCKET, SO_RCVBUF, &receive_buffer, sizeof(receive_buffer));
+    }
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(static_cast<uint16_t>(port_));
+    ASSERT_EQ(connect(client_fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+    ASSERT_TRUE(waitFor([this]() { return forwarder_.isConnected(); }));
+  }
+
+  std::vector<int32_t> receiveIntegers(size_t count)
+  {
+    std::vector<uint8_t> buffer(count * sizeof(int32_t));
+    size_t received = 0;
+    while (received < buffer.size()) {
+      pollfd fd = { client_fd_, POLLIN, 0 };
+      if (poll(&fd, 1, 2000) <= 0) {
+        break;
+      }
+      const ssize_t result = recv(client_fd_, buffer.data() + received, buffer.size() - received, 0);
+      if (result <= 0) {
+        break;
+      }
+      received += static_cast<size_t>(result);
+    }
+    EXPECT_EQ(received, buffer.size());
+
+    std::vector<int32_t> values(count, 0);
+    for (size_t i = 0; i < count && (i + 1) * sizeof(int32_t) <= received; ++i) {
+      uint32_t network;
+      std::memcpy(&network, buffer.data() + i * sizeof(network), sizeof(network));
+      values[i] = static_cast<int32_t>(ntohl(network));
+    }
+    return values;
+  }
+
+  void sendIntegers(const std::vector<int32_t>& values, size_t split)
+  {
+    std::vector<uint8_t> buffer;
+    for (const int32_t value : values) {
+      const uint32_t network = htonl(static_cast<uint32_t>(value));
+      const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&network);
+      buffer.insert(buffer.end(), bytes, bytes + sizeof(network));
+    }
+    // the report arrives in two pieces, as it may on a real connection
+    ASSERT_EQ(send(client_fd_, buffer.data(), split, 0), static_cast<ssize_t>(split));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_EQ(send(client_fd_, buffer.data() + split, buffer.size() - split, 0),
+              static_cast<ssize_t>(buffer.size() - split));
+  }
+
+  TrajectoryForwarder forwarder_;
+  int port_ = 0;
+  int client_fd_ = -1;
+};
+
+TEST_F(TrajectoryForwarderTest, point_is_sent_as_fixed_point_integers)
+{
+  connectClient();
+  const TrajectoryPoint point{ 7,
+                               2,
+                               5,
+                               { { 0.1, -0.2, 1.5, -3.14159, 0.0, 2.0 } },
+                               { { 0.5, 0.0, -0.25, 0.0, 1.0, -1.0 } },
+                               0.008 };
+  ASSERT_TRUE(forwarder_.postPoint(point));
+
+  const std::vector<int32_t> values = receiveIntegers(POINT_INTEGERS);
+  EXPECT_EQ(values[0], 7);
+  EXPECT_EQ(values[1], 2);
+  EXPECT_EQ(values[2], 5);
+  const std::vector<int32_t> expected = { 100000, -200000, 1500000, -3141590, 0,      2000000,
+                                          500000, 0,       -250000, 0,        1000000, -1000000 };
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(values[3 + i], expected[i]) << "value " << 3 + i;
+  }
+  EXPECT_EQ(values[15], 8000);
+
+  // nothing follows the point, so the next one starts right behind it
+  pollfd fd = { client_fd_, POLLIN, 0 };
+  EXPECT_EQ(poll(&fd, 1, 50), 0);
+}
+
+TEST_F(TrajectoryForwarderTest, points_keep_their_order)
+{
+  connectClient();
+  for (int32_t index = 1; index <= 10; ++index) {
+    ASSERT_TRUE(forwarder_.postPoint({ 3, index, 10, {}, {}, 0.1 }));
+  }
+  for (int32_t index = 1; index <= 10; ++index) {
+    const std::vector<int32_t> values = receiveIntegers(POINT_INTEGERS);
+    EXPECT_EQ(values[0], 3);
+    EXPECT_EQ(values[1], index);
+  }
+}
+
+TEST_F(TrajectoryForwarderTest, partial_report_is_assembled)
+{
+  connectClient();
+  sendIntegers({ 4, 9, static_cast<int32_t>(TrajectoryResult::SUCCESS) }, 5);
+
+  TrajectoryReport report;
+  ASSERT_TRUE(waitFor([this, &report]() { return forwarder_.takeReport(report); }));
+  EXPECT_EQ(report.trajectory_id, 4);
+  EXPECT_EQ(report.points_done, 9);
+  EXPECT_EQ(report.result, TrajectoryResult::SUCCESS);
+  EXPECT_FALSE(forwarder_.takeReport(report));
+}
+
+TEST_F(TrajectoryForwarderTest, closed_connection_is_detected)
+{
+  connectClient();
+  close(client_fd_);
+  client_fd_ = -1;
+  EXPECT_TRUE(waitFor([this]() { return !forwarder_.isConnected(); }));
+}
+
+TEST_F(TrajectoryForwarderTest, stop_returns_while_robot_program_does_not_read)
+{
+  connectClient(1024);
+  // fill the socket buffers, so the worker ends up waiting in send
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(500);
+  int32_t index = 1;
+  while (std::chrono::steady_clock::now() < deadline) {
+    if (!forwarder_.postPoint({ 1, index, 1000000, {}, {}, 0.1 })) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      continue;
+    }
+    ++index;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  forwarder_.stop();
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+}
@@ -0,0 +1,92 @@
+// Copyright 2026 FZI Forschungszentrum Informatik
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "ur_robot_driver/wrench_transform.hpp"
+
+using ur_robot_driver::transformWrenchToTool;
+
+namespace
+{
+// Rotates a vector by a rotation vector with Rodrigues' formula, independent of Eigen
+void rotate(const double rotation_vec[3], const double in[3], double out[3])
+{
+  const double angle = std::sqrt(rotation_vec[0] * rotation_vec[0] + rotation_vec[1] * rotation_vec[1] +
+                                 rotation_vec[2] * rotation_vec[2]);
+  const double k[3] = { rotation_vec[0] / angle, rotation_vec[1] / angle, rotation_vec[2] / angle };
+  const double cross[3] = { k[1] * in[2] - k[2] * in[1], k[2] * in[0] - k[0] * in[2], k[0] * in[1] - k[1] * in[0] };
+  const double dot = k[0] * in[0] + k[1] * in[1] + k[2] * in[2];
+  for (int i = 0; i < 3; ++i) {
+    out[i] = in[i] * std::cos(angle) + cross[i] * std::sin(angle) + k[i] * dot * (1.0 - std::cos(angle));
+  }
+}
+
+void expectWrenchNear(const urcl::vector6d_t& actual, const urcl::vector6d_t& expected)
+{
+  for (size_t i = 0; i < 6; ++i) {
+    EXPECT_NEAR(actual[i], expected[i], 1e-9) << "component " << i;
+  }
+}
+}  // namespace
+
+TEST(WrenchTransformTest, aligned_frames_keep_the_wrench)
+{
+  const urcl::vector6d_t pose = { { 0.4, -0.2, 0.3, 0.0, 0.0, 0.0 } };
+  urcl::vector6d_t wrench = { { 1.0, 2.0, 3.0, 0.1, 0.2, 0.3 } };
+  transformWrenchToTool(pose, wrench);
+  expectWrenchNear(wrench, { { 1.0, 2.0, 3.0, 0.1, 0.2, 0.3 } });
+}
+
+TEST(WrenchTransformTest, quarter_turn_about_z)
+{
+  // the tool x axis points along the base y axis
+  const urcl::vector6d_t pose = { { 0.0, 0.0, 0.0, 0.0, 0.0, M_PI / 2 } };
+  urcl::vector6d_t wrench = { { 1.0, 0.0, 5.0, 0.0, 2.0, 0.0 } };
+  transformWrenchToTool(pose, wrench);
+  expectWrenchNear(wrench, { { 0.0, -1.0, 5.0, 2.0, 0.0, 0.0 } });
+}
+
+TEST(WrenchTransformTest, half_turn_about_x)
+{
+  // tool pointing down, as usual for a robot mounted on a table
+  const urcl::vector6d_t pose = { { 0.0, 0.0, 0.0, M_PI, 0.0, 0.0 } };
+  urcl::vector6d_t wrench = { { 1.0, 2.0, -10.0, 0.5, 0.0, 0.25 } };
+  transformWrenchToTool(pose, wrench);
+  expectWrenchNear(wrench, { { 1.0, -2.0, 10.0, 0.5, 0.0, -0.25 } });
+}
+
+TEST(WrenchTransformTest, rotating_back_gives_the_base_wrench)
+{
+  const double rotation_vec[3] = { 0.3, -1.2, 2.1 };
+  const urcl::vector6d_t pose = { { 0.1, 0.2, 0.3, rotation_vec[0], rotation_vec[1], rotation_vec[2] } };
+  const urcl::vector6d_t base_wrench = { { 3.0, -4.0, 12.0, -0.7, 0.4, 1.1 } };
+  urcl::vector6d_t wrench = base_wrench;
+  transformWrenchToTool(pose, wrench);
+
+  // the tool frame wrench rotated by the TCP orientation is the base frame wrench again
+  urcl::vector6d_t rotated_back;
+  rotate(rotation_vec, wrench.data(), rotated_back.data());
+  rotate(rotation_vec, wrench.data() + 3, rotated_back.data() + 3);
+  expectWrenchNear(rotated_back, base_wrench);
+}